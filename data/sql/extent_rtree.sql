@@ -0,0 +1,41 @@
+-- R*Tree spatial index on the bounding boxes of the extent table, used to
+-- speed up queries filtering objects by an area of interest.
+-- Extents crossing the antimeridian (west_lon > east_lon) are split in two
+-- boxes, one on each side of it, so that all boxes have west_lon <= east_lon.
+-- As the R*Tree stores single precision coordinates, rounded outwards, it
+-- only gives candidates that must be checked against the extent table.
+
+CREATE VIRTUAL TABLE extent_rtree USING rtree(
+    id,
+    west_lon, east_lon,
+    south_lat, north_lat
+);
+
+-- Maps the id of a box of extent_rtree to its extent
+CREATE TABLE extent_rtree_code(
+    id INTEGER PRIMARY KEY,
+    auth_name TEXT NOT NULL,
+    code INTEGER_OR_TEXT NOT NULL
+);
+
+CREATE TEMP TABLE extent_box AS
+    SELECT auth_name, code, west_lon,
+           CASE WHEN west_lon > east_lon THEN 180 ELSE east_lon END AS east_lon,
+           south_lat, north_lat
+        FROM extent WHERE south_lat IS NOT NULL AND north_lat IS NOT NULL AND
+                          west_lon IS NOT NULL AND east_lon IS NOT NULL
+    UNION ALL
+    SELECT auth_name, code, -180 AS west_lon, east_lon, south_lat, north_lat
+        FROM extent WHERE south_lat IS NOT NULL AND north_lat IS NOT NULL AND
+                          west_lon > east_lon;
+
+INSERT INTO extent_rtree_code(id, auth_name, code)
+    SELECT rowid, auth_name, code FROM extent_box;
+
+INSERT INTO extent_rtree(id, west_lon, east_lon, south_lat, north_lat)
+    SELECT rowid, west_lon, east_lon, south_lat, north_lat FROM extent_box;
+
+DROP TABLE extent_box;
+
+CREATE INDEX extent_rtree_code_idx ON extent_rtree_code(auth_name, code);
+CREATE INDEX usage_extent_idx ON usage(extent_auth_name, extent_code);
@@ -0,0 +1,112 @@
+-- Fingerprint of the non-deprecated projected CRS whose conversion uses an
+-- EPSG method, used to find quickly the candidates of
+-- ProjectedCRS::identify().
+-- The fingerprint is made of the method code, the semi-major axis of the
+-- ellipsoid rounded to the metre, and a hash of the parameter values
+-- normalized to SI units, which is the sum over the EPSG parameters of
+-- param_code * 1000003 + round(value * scale), where scale is 1e2 for lengths
+-- and 1e6 for other units. The codes of the latitudes of the 1st and 2nd
+-- standard parallels are both counted as 8823, as they can be switched.
+-- This must be kept in sync with getProjectedCRSFingerprint() in
+-- src/iso19111/factory.cpp. As values are rounded, this is only a pre-filter
+-- whose candidates must be checked with isEquivalentTo().
+
+CREATE TABLE projected_crs_fingerprint(
+    auth_name TEXT NOT NULL,
+    code INTEGER_OR_TEXT NOT NULL,
+    method_code INTEGER NOT NULL,
+    semi_major_axis INTEGER NOT NULL,
+    parameters_hash INTEGER NOT NULL,
+    CONSTRAINT pk_projected_crs_fingerprint PRIMARY KEY (auth_name, code)
+);
+
+CREATE TEMP TABLE conversion_param AS
+    SELECT auth_name, code, param1_code AS param_code,
+           param1_value AS value, param1_uom_auth_name AS uom_auth_name,
+           param1_uom_code AS uom_code FROM conversion_table
+        WHERE param1_auth_name = 'EPSG' AND param1_value IS NOT NULL
+    UNION ALL
+    SELECT auth_name, code, param2_code, param2_value, param2_uom_auth_name,
+           param2_uom_code FROM conversion_table
+        WHERE param2_auth_name = 'EPSG' AND param2_value IS NOT NULL
+    UNION ALL
+    SELECT auth_name, code, param3_code, param3_value, param3_uom_auth_name,
+           param3_uom_code FROM conversion_table
+        WHERE param3_auth_name = 'EPSG' AND param3_value IS NOT NULL
+    UNION ALL
+    SELECT auth_name, code, param4_code, param4_value, param4_uom_auth_name,
+           param4_uom_code FROM conversion_table
+        WHERE param4_auth_name = 'EPSG' AND param4_value IS NOT NULL
+    UNION ALL
+    SELECT auth_name, code, param5_code, param5_value, param5_uom_auth_name,
+           param5_uom_code FROM conversion_table
+        WHERE param5_auth_name = 'EPSG' AND param5_value IS NOT NULL
+    UNION ALL
+    SELECT auth_name, code, param6_code, param6_value, param6_uom_auth_name,
+           param6_uom_code FROM conversion_table
+        WHERE param6_auth_name = 'EPSG' AND param6_value IS NOT NULL
+    UNION ALL
+    SELECT auth_name, code, param7_code, param7_value, param7_uom_auth_name,
+           param7_uom_code FROM conversion_table
+        WHERE param7_auth_name = 'EPSG' AND param7_value IS NOT NULL;
+
+-- Values in sexagesimal DMS (EPSG:9110, DDD.MMSSsss) are converted to degree
+CREATE TEMP TABLE conversion_param_dms AS
+    SELECT rowid AS id, abs(value) AS abs_value,
+           CAST(abs(value) AS INTEGER) AS deg,
+           CAST(round((abs(value) - CAST(abs(value) AS INTEGER)) * 100, 8)
+                AS INTEGER) AS min
+        FROM conversion_param
+        WHERE uom_auth_name = 'EPSG' AND uom_code = 9110;
+
+UPDATE conversion_param SET
+    value = (SELECT (CASE WHEN value < 0 THEN -1 ELSE 1 END) *
+                    (deg + min / 60.0 +
+                     ((abs_value - deg) * 100 - min) * 100 / 3600.0)
+             FROM conversion_param_dms WHERE id = conversion_param.rowid),
+    uom_code = 9102
+    WHERE uom_auth_name = 'EPSG' AND uom_code = 9110;
+
+CREATE TEMP TABLE conversion_hash AS
+    SELECT p.auth_name, p.code,
+           SUM((CASE WHEN p.param_code = 8824 THEN 8823
+                     ELSE p.param_code END) * 1000003 +
+               CAST(round(p.value * u.conv_factor *
+                          (CASE WHEN u.type = 'length' THEN 1e2
+                                ELSE 1e6 END)) AS INTEGER))
+               AS parameters_hash
+        FROM conversion_param p
+        JOIN unit_of_measure u ON
+            u.auth_name = p.uom_auth_name AND u.code = p.uom_code
+        GROUP BY p.auth_name, p.code;
+
+INSERT INTO projected_crs_fingerprint
+    SELECT projected_crs.auth_name, projected_crs.code, conv.method_code,
+           CAST(round(ellps.semi_major_axis * u.conv_factor) AS INTEGER),
+           COALESCE(h.parameters_hash, 0)
+        FROM projected_crs
+        JOIN conversion_table conv ON
+            conv.auth_name = projected_crs.conversion_auth_name AND
+            conv.code = projected_crs.conversion_code
+        JOIN geodetic_crs gcrs ON
+            gcrs.auth_name = projected_crs.geodetic_crs_auth_name AND
+            gcrs.code = projected_crs.geodetic_crs_code
+        JOIN geodetic_datum datum ON
+            datum.auth_name = gcrs.datum_auth_name AND
+            datum.code = gcrs.datum_code
+        JOIN ellipsoid ellps ON
+            ellps.auth_name = datum.ellipsoid_auth_name AND
+            ellps.code = datum.ellipsoid_code
+        JOIN unit_of_measure u ON
+            u.auth_name = ellps.uom_auth_name AND u.code = ellps.uom_code
+        LEFT JOIN conversion_hash h ON
+            h.auth_name = conv.auth_name AND h.code = conv.code
+        WHERE projected_crs.deprecated = 0 AND
+              conv.method_auth_name = 'EPSG';
+
+DROP TABLE conversion_hash;
+DROP TABLE conversion_param_dms;
+DROP TABLE conversion_param;
+
+CREATE INDEX projected_crs_fingerprint_idx ON projected_crs_fingerprint(
+    method_code, semi_major_axis, parameters_hash);
@@ -76,4 +76,6 @@ if (NOT PROJ_DB_EXTRA_VALIDATION)
 else()
   list(APPEND SQL_FILES "${SQL_DIR}/final_consistency_checks.sql")
 endif()
+list(APPEND SQL_FILES "${SQL_DIR}/extent_rtree.sql")
+list(APPEND SQL_FILES "${SQL_DIR}/projected_crs_fingerprint.sql")
 list(APPEND SQL_FILES "${SQL_DIR}/analyze_vacuum.sql")
@@ -64,6 +64,8 @@ namespace metadata {
 class Extent;
 using ExtentPtr = std::shared_ptr<Extent>;
 using ExtentNNPtr = util::nn<ExtentPtr>;
+class GeographicBoundingBox;
+using GeographicBoundingBoxPtr = std::shared_ptr<GeographicBoundingBox>;
 } // namespace metadata
 
 namespace datum {
@@ -1323,6 +1325,9 @@ class PROJ_GCC_DLL AuthorityFactory {
     createCoordinateReferenceSystem(const std::string &code,
                                     bool allowCompound) const;
 
+    PROJ_INTERNAL std::list<CRSInfo> getCRSInfoList(
+        const metadata::GeographicBoundingBoxPtr &intersectingBBox) const;
+
     PROJ_INTERNAL std::vector<operation::CoordinateOperationNNPtr>
     getTransformationsForGeoid(const std::string &geoidName,
                                bool usePROJAlternativeGridNames) const;
@@ -82,11 +82,41 @@ Thomas Knudsen, thokn@sdfe.dk, 2016-05-25/2017-10-26
 #include <cstdint>
 #include <fstream> // std::ifstream
 #include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(MSDOS) || defined(OS2) || defined(WIN32) || defined(__WIN32__)
+#include <fcntl.h>
+#include <io.h>
+#define SET_BINARY_MODE(file) _setmode(_fileno(file), O_BINARY)
+#else
+#define SET_BINARY_MODE(file)
+#endif
 
 #include "optargpm.h"
 #include "proj.h"
 #include "proj_internal.h"
 #include "proj_strtod.h"
+#include "utils.h"
+
+/* Settings for the transformation and formatting of text input lines */
+struct TextSettings {
+    const char *progname = nullptr;
+    int *columns_xyzt = nullptr;
+    bool columns_given = false;
+    int nfields = 4;
+    double fixed_z = HUGE_VAL;
+    double fixed_time = HUGE_VAL;
+    int decimals_angles = 10;
+    int decimals_distances = 4;
+};
+
+/* Text input line, with its location in the input files */
+struct InputLine {
+    std::string text{};
+    int record_index = 0;
+    const char *filename = nullptr;
+};
 
 static void logger(void *data, int level, const char *msg);
 static void print(PJ_LOG_LEVEL log_level, const char *fmt, ...);
@@ -96,6 +126,16 @@ static const char *column(const char *buf, int n);
 static char *column(char *buf, int n);
 PJ_COORD parse_input_line(const char *buf, int *columns, double fixed_height,
                           double fixed_time);
+static bool parse_binary_layout(const char *layout,
+                                std::vector<int> &layout_xyzt);
+static bool process_binary_input(OPTARGS *o, PJ *P,
+                                 const std::vector<PJ *> &workers,
+                                 const std::vector<int> &layout_xyzt,
+                                 double fixed_height, double fixed_time,
+                                 int skip_records);
+static void append_line(std::string &out, const char *fmt, ...);
+static void process_line(PJ *P, InputLine &line, const TextSettings &settings,
+                         std::string &out);
 
 static const char usage[] = {
     "--------------------------------------------------------------------------"
@@ -116,7 +156,9 @@ static const char usage[] = {
     "0)\n"
     "    -z value          Provide a fixed z value for all input data (e.g. -z "
     "0)\n"
-    "    -s n              Skip n first lines of a infile\n"
+    "    -j n              Transform the input with n threads\n"
+    "    -s n              Skip n first lines (or binary records) of a "
+    "infile\n"
     "    -v                Verbose: Provide non-essential informational "
     "output.\n"
     "                      Repeat -v for more verbosity (e.g. -vv)\n"
@@ -133,8 +175,13 @@ static const char usage[] = {
     "    --verbose         Alias for -v\n"
     "    --inverse         Alias for -I\n"
     "    --skip-lines      Alias for -s\n"
+    "    --threads         Alias for -j\n"
     "    --help            Alias for -h\n"
     "    --version         Print version number\n"
+    "    --binary layout   Read and write records of little-endian float64\n"
+    "                      values in the order given by layout (e.g. xy, "
+    "xyzt)\n"
+    "    --no-flush        Do not flush stdout after each output record\n"
     "--------------------------------------------------------------------------"
     "------\n"
     "Operator Specs:\n"
@@ -217,28 +264,26 @@ static void print(PJ_LOG_LEVEL log_level, const char *fmt, ...) {
 
 int main(int argc, char **argv) {
     PJ *P = nullptr;
-    PJ_COORD point;
     PJ_PROJ_INFO info;
     OPTARGS *o;
-    char blank_comment[] = "";
-    char whitespace[] = " ";
-    int i, nfields = 4, skip_lines = 0, verbose;
+    int i, nfields = 4, skip_lines = 0, nthreads = 1, verbose;
     double fixed_z = HUGE_VAL, fixed_time = HUGE_VAL;
     int decimals_angles = 10;
     int decimals_distances = 4;
     int columns_xyzt[] = {1, 2, 3, 4};
-    const char *longflags[] = {"v=verbose", "h=help", "I=inverse", "version",
-                               nullptr};
-    const char *longkeys[] = {"o=output", "c=columns", "d=decimals",
-                              "z=height", "t=time",    "s=skip-lines",
-                              nullptr};
+    const char *longflags[] = {"v=verbose", "h=help",     "I=inverse",
+                               "version",   "no-flush", nullptr};
+    const char *longkeys[] = {"o=output",   "c=columns", "d=decimals",
+                              "z=height",   "t=time",    "s=skip-lines",
+                              "j=threads", "binary",    nullptr};
+    std::vector<int> binary_layout_xyzt;
 
     fout = stdout;
 
     pj_stderr_proj_lib_deprecation_warning();
 
     /* coverity[tainted_data] */
-    o = opt_parse(argc, argv, "hvI", "cdozts", longflags, longkeys);
+    o = opt_parse(argc, argv, "hvI", "cdoztsj", longflags, longkeys);
     if (nullptr == o)
         return 1;
 
@@ -263,8 +308,25 @@ int main(int argc, char **argv) {
         return 0;
     }
 
+    const bool binary = opt_given(o, "binary") != 0;
+    if (binary &&
+        !parse_binary_layout(opt_arg(o, "binary"), binary_layout_xyzt)) {
+        print(PJ_LOG_ERROR,
+              "%s: Invalid binary layout '%s'. It must list x, y and "
+              "optionally z and t, each at most once",
+              o->progname, opt_arg(o, "binary"));
+        free(o);
+        return 1;
+    }
+    if (binary && opt_given(o, "c")) {
+        print(PJ_LOG_ERROR, "%s: -c cannot be used with --binary",
+              o->progname);
+        free(o);
+        return 1;
+    }
+
     if (opt_given(o, "o"))
-        fout = fopen(opt_arg(o, "output"), "wt");
+        fout = fopen(opt_arg(o, "output"), binary ? "wb" : "wt");
     if (nullptr == fout) {
         print(PJ_LOG_ERROR, "%s: Cannot open '%s' for output", o->progname,
               opt_arg(o, "output"));
@@ -294,6 +356,18 @@ int main(int argc, char **argv) {
         skip_lines = atoi(opt_arg(o, "s"));
     }
 
+    if (opt_given(o, "j")) {
+        nthreads = atoi(opt_arg(o, "j"));
+        if (nthreads < 1) {
+            print(PJ_LOG_ERROR, "%s: Invalid number of threads: '%s'",
+                  o->progname, opt_arg(o, "j"));
+            free(o);
+            if (stdout != fout)
+                fclose(fout);
+            return 1;
+        }
+    }
+
     if (opt_given(o, "c")) {
         int ncols;
         /* reset column numbers to ease comment output later on */
@@ -432,11 +506,46 @@ int main(int argc, char **argv) {
     }
     direction = PJ_FWD;
 
+    std::vector<PJ *> workers;
+    if (nthreads > 1) {
+        workers = clone_for_threads(P, nthreads - 1);
+        for (PJ *worker : workers)
+            worker->inverted = P->inverted;
+    }
+
+    if (binary) {
+        SET_BINARY_MODE(stdin);
+        if (fout == stdout) {
+            SET_BINARY_MODE(stdout);
+        }
+        const bool ok = process_binary_input(o, P, workers, binary_layout_xyzt,
+                                             fixed_z, fixed_time, skip_lines);
+        destroy_clones_for_threads(workers);
+        proj_destroy(P);
+        if (stdout != fout)
+            fclose(fout);
+        free(o);
+        return ok ? 0 : 1;
+    }
+
+    const bool flush_output = fout == stdout && !opt_given(o, "no-flush");
+
+    TextSettings settings;
+    settings.progname = o->progname;
+    settings.columns_xyzt = columns_xyzt;
+    settings.columns_given = opt_given(o, "c") != 0;
+    settings.nfields = nfields;
+    settings.fixed_z = fixed_z;
+    settings.fixed_time = fixed_time;
+    settings.decimals_angles = decimals_angles;
+    settings.decimals_distances = decimals_distances;
+
     /* Allocate input buffer */
     constexpr int BUFFER_SIZE = 10000;
     char *buf = static_cast<char *>(calloc(1, BUFFER_SIZE));
     if (nullptr == buf) {
         print(PJ_LOG_ERROR, "%s: Out of memory", o->progname);
+        destroy_clones_for_threads(workers);
         proj_destroy(P);
         free(o);
         if (stdout != fout)
@@ -444,11 +553,38 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    /* With -j, input lines are read by chunks, and each chunk is split in */
+    /* as many ranges as threads, each transformed with its own clone of   */
+    /* P, writing its output to its own buffer. The buffers are then       */
+    /* written in order.                                                   */
+    const int nranges = static_cast<int>(workers.size()) + 1;
+    constexpr size_t LINES_PER_THREAD = 10000;
+    const size_t chunk_size = workers.empty() ? 1 : LINES_PER_THREAD * nranges;
+    std::vector<InputLine> lines;
+    std::vector<std::string> outs(nranges);
+    const auto flush_lines = [&]() {
+        process_ranges_in_threads(
+            lines.size(), nranges,
+            [&lines, &outs, &workers, &settings, P](int irange, size_t start,
+                                                    size_t count) {
+                PJ *worker = irange == 0 ? P : workers[irange - 1];
+                std::string &out = outs[irange];
+                for (size_t iline = start; iline < start + count; iline++)
+                    process_line(worker, lines[iline], settings, out);
+            });
+        lines.clear();
+        for (auto &out : outs) {
+            fwrite(out.data(), 1, out.size(), fout);
+            out.clear();
+        }
+        if (flush_output)
+            fflush(stdout);
+    };
+
     /* Loop over all records of all input files */
     int previous_index = -1;
     bool gotError = false;
     while (opt_input_loop(o, optargs_file_format_text, &gotError)) {
-        int err;
         char *bufptr = fgets(buf, BUFFER_SIZE - 1, o->input);
         if (opt_eof(o)) {
             continue;
@@ -468,84 +604,23 @@ int main(int argc, char **argv) {
             bufptr += 3;
         }
 
-        point = parse_input_line(bufptr, columns_xyzt, fixed_z, fixed_time);
         if (skip_lines > 0) {
             skip_lines--;
             continue;
         }
 
-        /* if it's a comment or blank line, we reflect it */
-        const char *c = column(bufptr, 1);
-        if (c && ((*c == '\0') || (*c == '#'))) {
-            fprintf(fout, "%s", bufptr);
-            continue;
-        }
-
-        if (HUGE_VAL == point.xyzt.x) {
-            /* otherwise, it must be a syntax error */
-            print(PJ_LOG_NONE, "# Record %d UNREADABLE: %s",
-                  (int)o->record_index, bufptr);
-            print(PJ_LOG_ERROR, "%s: Could not parse file '%s' line %d",
-                  o->progname, opt_filename(o), opt_record(o));
-            continue;
-        }
-
-        if (proj_angular_input(P, direction)) {
-            point.lpzt.lam = proj_torad(point.lpzt.lam);
-            point.lpzt.phi = proj_torad(point.lpzt.phi);
-        }
-        err = proj_errno_reset(P);
-        /* coverity[returned_value] */
-        point = proj_trans(P, direction, point);
-
-        if (HUGE_VAL == point.xyzt.x) {
-            /* transformation error */
-            print(PJ_LOG_NONE, "# Record %d TRANSFORMATION ERROR: %s (%s)",
-                  (int)o->record_index, bufptr,
-                  proj_errno_string(proj_errno(P)));
-            proj_errno_restore(P, err);
-            continue;
-        }
-        proj_errno_restore(P, err);
-
-        /* handle comment string */
-        char *comment = column(bufptr, nfields + 1);
-        if (opt_given(o, "c")) {
-            /* what number is the last coordinate column in the input data? */
-            int colmax = 0;
-            for (i = 0; i < 4; i++)
-                colmax = MAX(colmax, columns_xyzt[i]);
-            comment = column(bufptr, colmax + 1);
-        }
-        /* remove the line feed from comment, as logger() above, invoked
-           by print() below (output), will add one */
-        size_t len = strlen(comment);
-        if (len >= 1)
-            comment[len - 1] = '\0';
-        const char *comment_delimiter = *comment ? whitespace : blank_comment;
-
-        /* Time to print the result */
-        /* use same arguments to printf format string for both radians and
-           degrees; convert radians to degrees before printing */
-        if (proj_angular_output(P, direction) ||
-            proj_degree_output(P, direction)) {
-            if (proj_angular_output(P, direction)) {
-                point.lpzt.lam = proj_todeg(point.lpzt.lam);
-                point.lpzt.phi = proj_todeg(point.lpzt.phi);
-            }
-            print(PJ_LOG_NONE, "%14.*f  %14.*f  %12.*f  %12.4f%s%s",
-                  decimals_angles, point.xyzt.x, decimals_angles, point.xyzt.y,
-                  decimals_distances, point.xyzt.z, point.xyzt.t,
-                  comment_delimiter, comment);
-        } else
-            print(PJ_LOG_NONE, "%13.*f  %13.*f  %12.*f  %12.4f%s%s",
-                  decimals_distances, point.xyzt.x, decimals_distances,
-                  point.xyzt.y, decimals_distances, point.xyzt.z, point.xyzt.t,
-                  comment_delimiter, comment);
-        if (fout == stdout)
-            fflush(stdout);
+        InputLine line;
+        line.text = bufptr;
+        line.record_index = (int)o->record_index;
+        line.filename = opt_filename(o);
+        lines.emplace_back(std::move(line));
+        if (lines.size() == chunk_size)
+            flush_lines();
     }
+    if (!lines.empty())
+        flush_lines();
 
+    destroy_clones_for_threads(workers);
     proj_destroy(P);
 
     if (stdout != fout)
@@ -555,6 +630,109 @@ int main(int argc, char **argv) {
     return gotError ? 1 : 0;
 }
 
+/* append a printf-style formatted message, followed by a line feed, to out */
+static void append_line(std::string &out, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list args_copy;
+    va_copy(args_copy, args);
+    const int len = vsnprintf(nullptr, 0, fmt, args_copy);
+    va_end(args_copy);
+    if (len > 0) {
+        const size_t old_size = out.size();
+        out.resize(old_size + len + 1);
+        vsnprintf(&out[old_size], len + 1, fmt, args);
+        out.resize(old_size + len);
+    }
+    va_end(args);
+    out += '\n';
+}
+
+/* Transform one input line with P, and append the corresponding output to out.
+   Error messages are written to stderr. */
+static void process_line(PJ *P, InputLine &line, const TextSettings &settings,
+                         std::string &out) {
+    char blank_comment[] = "";
+    char whitespace[] = " ";
+    char *bufptr = &line.text[0];
+    const PJ_DIRECTION direction = PJ_FWD;
+
+    PJ_COORD point =
+        parse_input_line(bufptr, settings.columns_xyzt, settings.fixed_z,
+                         settings.fixed_time);
+
+    /* if it's a comment or blank line, we reflect it */
+    const char *c = column(bufptr, 1);
+    if (c && ((*c == '\0') || (*c == '#'))) {
+        out += bufptr;
+        return;
+    }
+
+    if (HUGE_VAL == point.xyzt.x) {
+        /* otherwise, it must be a syntax error */
+        append_line(out, "# Record %d UNREADABLE: %s", line.record_index,
+                    bufptr);
+        print(PJ_LOG_ERROR, "%s: Could not parse file '%s' line %d",
+              settings.progname, line.filename, line.record_index + 1);
+        return;
+    }
+
+    if (proj_angular_input(P, direction)) {
+        point.lpzt.lam = proj_torad(point.lpzt.lam);
+        point.lpzt.phi = proj_torad(point.lpzt.phi);
+    }
+    const int err = proj_errno_reset(P);
+    /* coverity[returned_value] */
+    point = proj_trans(P, direction, point);
+
+    if (HUGE_VAL == point.xyzt.x) {
+        /* transformation error */
+        append_line(out, "# Record %d TRANSFORMATION ERROR: %s (%s)",
+                    line.record_index, bufptr,
+                    proj_errno_string(proj_errno(P)));
+        proj_errno_restore(P, err);
+        return;
+    }
+    proj_errno_restore(P, err);
+
+    /* handle comment string */
+    char *comment = column(bufptr, settings.nfields + 1);
+    if (settings.columns_given) {
+        /* what number is the last coordinate column in the input data? */
+        int colmax = 0;
+        for (int i = 0; i < 4; i++)
+            colmax = MAX(colmax, settings.columns_xyzt[i]);
+        comment = column(bufptr, colmax + 1);
+    }
+    /* remove the line feed from comment, as append_line() below will add
+       one */
+    size_t len = strlen(comment);
+    if (len >= 1)
+        comment[len - 1] = '\0';
+    const char *comment_delimiter = *comment ? whitespace : blank_comment;
+
+    /* Time to print the result */
+    /* use same arguments to printf format string for both radians and
+       degrees; convert radians to degrees before printing */
+    const int decimals_angles = settings.decimals_angles;
+    const int decimals_distances = settings.decimals_distances;
+    if (proj_angular_output(P, direction) ||
+        proj_degree_output(P, direction)) {
+        if (proj_angular_output(P, direction)) {
+            point.lpzt.lam = proj_todeg(point.lpzt.lam);
+            point.lpzt.phi = proj_todeg(point.lpzt.phi);
+        }
+        append_line(out, "%14.*f  %14.*f  %12.*f  %12.4f%s%s",
+                    decimals_angles, point.xyzt.x, decimals_angles,
+                    point.xyzt.y, decimals_distances, point.xyzt.z,
+                    point.xyzt.t, comment_delimiter, comment);
+    } else
+        append_line(out, "%13.*f  %13.*f  %12.*f  %12.4f%s%s",
+                    decimals_distances, point.xyzt.x, decimals_distances,
+                    point.xyzt.y, decimals_distances, point.xyzt.z,
+                    point.xyzt.t, comment_delimiter, comment);
+}
+
 /* return a pointer to the n'th column of buf */
 static const char *column(const char *buf, int n) {
     int i;
@@ -608,3 +786,131 @@ PJ_COORD parse_input_line(const char *buf, int *columns, double fixed_height,
     errno = prev_errno;
     return result;
 }
+
+/* parse a --binary layout such as "xy" or "xyzt" into component indices */
+static bool parse_binary_layout(const char *layout,
+                                std::vector<int> &layout_xyzt) {
+    static const char components[] = "xyzt";
+    bool seen[4] = {false, false, false, false};
+    layout_xyzt.clear();
+    for (const char *c = layout; *c; c++) {
+        const char *pos =
+            strchr(components, tolower(static_cast<unsigned char>(*c)));
+        if (pos == nullptr || *pos == '\0')
+            return false;
+        const int idx = static_cast<int>(pos - components);
+        if (seen[idx])
+            return false;
+        seen[idx] = true;
+        layout_xyzt.push_back(idx);
+    }
+    return seen[0] && seen[1];
+}
+
+static bool host_is_little_endian() {
+    const uint16_t one = 1;
+    return *reinterpret_cast<const uint8_t *>(&one) == 1;
+}
+
+static void swap_double_bytes(unsigned char *ptr, size_t count) {
+    for (size_t i = 0; i < count; i++, ptr += sizeof(double))
+        std::reverse(ptr, ptr + sizeof(double));
+}
+
+/* Transform binary records of float64 values read from all input files, in
+   blocks through proj_trans_array(), and write them with the same layout.
+   Points that fail to transform are written as HUGE_VAL. */
+static bool process_binary_input(OPTARGS *o, PJ *P,
+                                 const std::vector<PJ *> &workers,
+                                 const std::vector<int> &layout_xyzt,
+                                 double fixed_height, double fixed_time,
+                                 int skip_records) {
+    constexpr size_t BLOCK_RECORDS = 65536;
+    const size_t ncomps = layout_xyzt.size();
+    const size_t record_size = ncomps * sizeof(double);
+    const bool swap = !host_is_little_endian();
+    const bool angular_input = proj_angular_input(P, PJ_FWD) != 0;
+    const bool angular_output = proj_angular_output(P, PJ_FWD) != 0;
+
+    std::vector<double> values(BLOCK_RECORDS * ncomps);
+    std::vector<PJ_COORD> coords(BLOCK_RECORDS);
+    auto bytes = reinterpret_cast<unsigned char *>(values.data());
+
+    bool ok = true;
+    bool gotError = false;
+    while (opt_input_loop(o, optargs_file_format_binary, &gotError)) {
+        const size_t nbytes =
+            fread(bytes, 1, BLOCK_RECORDS * record_size, o->input);
+        if (ferror(o->input)) {
+            print(PJ_LOG_ERROR, "%s: Read error in '%s'", o->progname,
+                  opt_filename(o));
+            ok = false;
+            break;
+        }
+        size_t n = nbytes / record_size;
+        if (nbytes % record_size != 0) {
+            print(PJ_LOG_ERROR, "%s: Truncated last record in '%s'",
+                  o->progname, opt_filename(o));
+            ok = false;
+        }
+
+        size_t first = 0;
+        if (skip_records > 0) {
+            first = std::min(n, static_cast<size_t>(skip_records));
+            skip_records -= static_cast<int>(first);
+        }
+        n -= first;
+        if (n == 0)
+            continue;
+        double *block = values.data() + first * ncomps;
+        if (swap)
+            swap_double_bytes(reinterpret_cast<unsigned char *>(block),
+                              n * ncomps);
+
+        for (size_t i = 0; i < n; i++) {
+            double xyzt[4] = {0.0, 0.0, 0.0, HUGE_VAL};
+            const double *record = block + i * ncomps;
+            for (size_t j = 0; j < ncomps; j++)
+                xyzt[layout_xyzt[j]] = record[j];
+            if (fixed_height != HUGE_VAL)
+                xyzt[2] = fixed_height;
+            if (fixed_time != HUGE_VAL)
+                xyzt[3] = fixed_time;
+            if (angular_input) {
+                xyzt[0] = proj_torad(xyzt[0]);
+                xyzt[1] = proj_torad(xyzt[1]);
+            }
+            coords[i] = proj_coord(xyzt[0], xyzt[1], xyzt[2], xyzt[3]);
+        }
+
+        const int err = proj_errno_reset(P);
+        process_ranges_in_threads(
+            n, static_cast<int>(workers.size()) + 1,
+            [P, &workers, &coords](int irange, size_t start, size_t count) {
+                PJ *worker = irange == 0 ? P : workers[irange - 1];
+                proj_trans_array(worker, PJ_FWD, count, coords.data() + start);
+            });
+        proj_errno_restore(P, err);
+
+        for (size_t i = 0; i < n; i++) {
+            double *record = block + i * ncomps;
+            const PJ_COORD &point = coords[i];
+            const bool failed = point.xyzt.x == HUGE_VAL;
+            for (size_t j = 0; j < ncomps; j++) {
+                double v = point.v[layout_xyzt[j]];
+                if (angular_output && layout_xyzt[j] < 2 && !failed)
+                    v = proj_todeg(v);
+                record[j] = v;
+            }
+        }
+        if (swap)
+            swap_double_bytes(reinterpret_cast<unsigned char *>(block),
+                              n * ncomps);
+        if (fwrite(block, record_size, n, fout) != n) {
+            print(PJ_LOG_ERROR, "%s: Write error", o->progname);
+            ok = false;
+            break;
+        }
+    }
+    return ok && !gotError;
+}
@@ -60,6 +60,7 @@
 #define MAX_LINE 1000
 
 static PJ *transformation = nullptr;
+static std::vector<PJ *> workers; /* clones of transformation used by -j */
 
 static bool srcIsLongLat = false;
 static double srcToRadians = 0.0;
@@ -80,7 +81,7 @@ static const char *oform =
 static char oform_buffer[16]; /* buffer for oform when using -d */
 static const char *oterr = "*\t*"; /* output line for unprojectable input */
 static const char *usage =
-    "%s\nusage: %s [-dDeEfIlrstvwW [args]]\n"
+    "%s\nusage: %s [-dDeEfIjlrstvwW [args]]\n"
     "              [[--area name_or_code] | [--bbox "
     "west_long,south_lat,east_long,north_lat]]\n"
     "              [--authority {name}] [--3d]\n"
@@ -98,171 +99,234 @@ using namespace NS_PROJ::util;
 using namespace NS_PROJ::internal;
 
 /************************************************************************/
-/*                              process()                               */
+/*                           process_line()                             */
 /*                                                                      */
-/*      File processing function.                                       */
+/*      Transform one input line with P, and append the corresponding   */
+/*      output line to out.                                             */
 /************************************************************************/
-static void process(FILE *fid)
+static void process_line(PJ *P, char *line, int nLineNumber, std::string &out)
 
 {
-    char line[MAX_LINE + 3], *s, pline[40];
+    char *s = line, pline[40], number[2100];
     PJ_UV data;
-    int nLineNumber = 0;
+    double z;
 
-    while (true) {
-        double z;
-        ++nLineNumber;
-        ++emess_dat.File_line;
-        if (!(s = fgets(line, MAX_LINE, fid)))
-            break;
+    if (nLineNumber == 1 && static_cast<uint8_t>(s[0]) == 0xEF &&
+        static_cast<uint8_t>(s[1]) == 0xBB &&
+        static_cast<uint8_t>(s[2]) == 0xBF) {
+        // Skip UTF-8 Byte Order Marker (BOM)
+        s += 3;
+    }
+    const char *pszLineAfterBOM = s;
 
-        if (nLineNumber == 1 && static_cast<uint8_t>(s[0]) == 0xEF &&
-            static_cast<uint8_t>(s[1]) == 0xBB &&
-            static_cast<uint8_t>(s[2]) == 0xBF) {
-            // Skip UTF-8 Byte Order Marker (BOM)
-            s += 3;
-        }
-        const char *pszLineAfterBOM = s;
-
-        if (!strchr(s, '\n')) { /* overlong line */
-            int c;
-            (void)strcat(s, "\n");
-            /* gobble up to newline */
-            while ((c = fgetc(fid)) != EOF && c != '\n')
-                ;
-        }
-        if (*s == tag) {
-            fputs(line, stdout);
-            continue;
-        }
+    if (*s == tag) {
+        out += line;
+        return;
+    }
 
-        if (reversein) {
-            data.v = (*informat)(s, &s);
-            data.u = (*informat)(s, &s);
-        } else {
-            data.u = (*informat)(s, &s);
-            data.v = (*informat)(s, &s);
-        }
+    if (reversein) {
+        data.v = (*informat)(s, &s);
+        data.u = (*informat)(s, &s);
+    } else {
+        data.u = (*informat)(s, &s);
+        data.v = (*informat)(s, &s);
+    }
 
-        z = strtod(s, &s);
-
-        /* To avoid breaking existing tests, we read what is a possible t    */
-        /* component of the input and rewind the s-pointer so that the final */
-        /* output has consistent behavior, with or without t values.        */
-        /* This is a bit of a hack, in most cases 4D coordinates will be     */
-        /* written to STDOUT (except when using -E) but the output format    */
-        /* specified with -f is not respected for the t component, rather it */
-        /* is forward verbatim from the input.                               */
-        char *before_time = s;
-        double t = strtod(s, &s);
-        if (s == before_time) {
-            t = HUGE_VAL;
-            if (srcIsDynamic) {
-                fprintf(
-                    stderr,
+    z = strtod(s, &s);
+
+    /* To avoid breaking existing tests, we read what is a possible t    */
+    /* component of the input and rewind the s-pointer so that the final */
+    /* output has consistent behavior, with or without t values.        */
+    /* This is a bit of a hack, in most cases 4D coordinates will be     */
+    /* written to STDOUT (except when using -E) but the output format    */
+    /* specified with -f is not respected for the t component, rather it */
+    /* is forward verbatim from the input.                               */
+    char *before_time = s;
+    double t = strtod(s, &s);
+    if (s == before_time) {
+        t = HUGE_VAL;
+        if (srcIsDynamic) {
+            fprintf(stderr,
                     "Input coordinates lack a coordinate epoch, whereas the "
                     "source CRS is dynamic. Results might be inaccurate.\n");
-            } else if (destIsDynamic) {
-                fprintf(stderr, "Input coordinates lack a coordinate epoch, "
-                                "whereas the destination CRS is dynamic. "
-                                "Results might be inaccurate.\n");
-            }
+        } else if (destIsDynamic) {
+            fprintf(stderr, "Input coordinates lack a coordinate epoch, "
+                            "whereas the destination CRS is dynamic. "
+                            "Results might be inaccurate.\n");
         }
-        s = before_time;
+    }
+    s = before_time;
 
-        if (data.v == HUGE_VAL)
-            data.u = HUGE_VAL;
+    if (data.v == HUGE_VAL)
+        data.u = HUGE_VAL;
 
-        if (!*s && (s > line))
-            --s; /* assumed we gobbled \n */
+    if (!*s && (s > line))
+        --s; /* assumed we gobbled \n */
+
+    if (echoin) {
+        out.append(pszLineAfterBOM, s - pszLineAfterBOM);
+        out += '\t';
+    }
 
-        if (echoin) {
-            char temp;
-            temp = *s;
-            *s = '\0';
-            (void)fputs(pszLineAfterBOM, stdout);
-            *s = temp;
-            putchar('\t');
+    if (data.u != HUGE_VAL) {
+
+        if (srcIsLongLat && fabs(srcToRadians - M_PI / 180) < 1e-10) {
+            /* dmstor gives values to radians. Convert now to the SRS unit
+             */
+            data.u /= srcToRadians;
+            data.v /= srcToRadians;
         }
 
-        if (data.u != HUGE_VAL) {
+        PJ_COORD coord;
+        coord.xyzt.x = data.u;
+        coord.xyzt.y = data.v;
+        coord.xyzt.z = z;
+        coord.xyzt.t = t;
+        coord = proj_trans(P, PJ_FWD, coord);
+        data.u = coord.xyz.x;
+        data.v = coord.xyz.y;
+        z = coord.xyz.z;
+    }
+
+    if (data.u == HUGE_VAL) /* error output */
+        out += oterr;
+
+    else if (destIsLongLat && !oform) { /*ascii DMS output */
+
+        // rtodms() expect radians: convert from the output SRS unit
+        data.u *= destToRadians;
+        data.v *= destToRadians;
 
-            if (srcIsLongLat && fabs(srcToRadians - M_PI / 180) < 1e-10) {
-                /* dmstor gives values to radians. Convert now to the SRS unit
-                 */
-                data.u /= srcToRadians;
-                data.v /= srcToRadians;
+        if (destIsLatLong) {
+            if (reverseout) {
+                out += rtodms(pline, sizeof(pline), data.v, 'E', 'W');
+                out += '\t';
+                out += rtodms(pline, sizeof(pline), data.u, 'N', 'S');
+            } else {
+                out += rtodms(pline, sizeof(pline), data.u, 'N', 'S');
+                out += '\t';
+                out += rtodms(pline, sizeof(pline), data.v, 'E', 'W');
             }
+        } else if (reverseout) {
+            out += rtodms(pline, sizeof(pline), data.v, 'N', 'S');
+            out += '\t';
+            out += rtodms(pline, sizeof(pline), data.u, 'E', 'W');
+        } else {
+            out += rtodms(pline, sizeof(pline), data.u, 'E', 'W');
+            out += '\t';
+            out += rtodms(pline, sizeof(pline), data.v, 'N', 'S');
+        }
 
-            PJ_COORD coord;
-            coord.xyzt.x = data.u;
-            coord.xyzt.y = data.v;
-            coord.xyzt.z = z;
-            coord.xyzt.t = t;
-            coord = proj_trans(transformation, PJ_FWD, coord);
-            data.u = coord.xyz.x;
-            data.v = coord.xyz.y;
-            z = coord.xyz.z;
+    } else { /* x-y or decimal degree ascii output */
+        if (destIsLongLat) {
+            data.v *= destToRadians * RAD_TO_DEG;
+            data.u *= destToRadians * RAD_TO_DEG;
         }
+        if (limited_snprintf_for_number(number, sizeof(number), oform,
+                                        reverseout ? data.v : data.u))
+            out += number;
+        out += '\t';
+        if (limited_snprintf_for_number(number, sizeof(number), oform,
+                                        reverseout ? data.u : data.v))
+            out += number;
+    }
 
-        if (data.u == HUGE_VAL) /* error output */
-            fputs(oterr, stdout);
+    out += ' ';
+    if (oform != nullptr) {
+        if (limited_snprintf_for_number(number, sizeof(number), oform, z))
+            out += number;
+    } else {
+        snprintf(number, sizeof(number), "%.3f", z);
+        out += number;
+    }
+    if (s)
+        out += s;
+    else
+        out += '\n';
+}
 
-        else if (destIsLongLat && !oform) { /*ascii DMS output */
+/************************************************************************/
+/*                              read_line()                             */
+/*                                                                      */
+/*      Read a line of at most MAX_LINE characters from fid, and skip   */
+/*      the rest of overlong lines.                                     */
+/************************************************************************/
+static bool read_line(FILE *fid, char *line) {
+    ++emess_dat.File_line;
+    if (!fgets(line, MAX_LINE, fid))
+        return false;
+    if (!strchr(line, '\n')) { /* overlong line */
+        int c;
+        (void)strcat(line, "\n");
+        /* gobble up to newline */
+        while ((c = fgetc(fid)) != EOF && c != '\n')
+            ;
+    }
+    return true;
+}
 
-            // rtodms() expect radians: convert from the output SRS unit
-            data.u *= destToRadians;
-            data.v *= destToRadians;
+/************************************************************************/
+/*                              process()                               */
+/*                                                                      */
+/*      File processing function.                                       */
+/************************************************************************/
+static void process(FILE *fid)
 
-            if (destIsLatLong) {
-                if (reverseout) {
-                    fputs(rtodms(pline, sizeof(pline), data.v, 'E', 'W'),
-                          stdout);
-                    putchar('\t');
-                    fputs(rtodms(pline, sizeof(pline), data.u, 'N', 'S'),
-                          stdout);
-                } else {
-                    fputs(rtodms(pline, sizeof(pline), data.u, 'N', 'S'),
-                          stdout);
-                    putchar('\t');
-                    fputs(rtodms(pline, sizeof(pline), data.v, 'E', 'W'),
-                          stdout);
-                }
-            } else if (reverseout) {
-                fputs(rtodms(pline, sizeof(pline), data.v, 'N', 'S'), stdout);
-                putchar('\t');
-                fputs(rtodms(pline, sizeof(pline), data.u, 'E', 'W'), stdout);
-            } else {
-                fputs(rtodms(pline, sizeof(pline), data.u, 'E', 'W'), stdout);
-                putchar('\t');
-                fputs(rtodms(pline, sizeof(pline), data.v, 'N', 'S'), stdout);
-            }
+{
+    char line[MAX_LINE + 3];
+    std::string out;
+    int nLineNumber = 0;
 
-        } else { /* x-y or decimal degree ascii output */
-            if (destIsLongLat) {
-                data.v *= destToRadians * RAD_TO_DEG;
-                data.u *= destToRadians * RAD_TO_DEG;
-            }
-            if (reverseout) {
-                limited_fprintf_for_number(stdout, oform, data.v);
-                putchar('\t');
-                limited_fprintf_for_number(stdout, oform, data.u);
-            } else {
-                limited_fprintf_for_number(stdout, oform, data.u);
-                putchar('\t');
-                limited_fprintf_for_number(stdout, oform, data.v);
+    if (workers.empty()) {
+        while (read_line(fid, line)) {
+            ++nLineNumber;
+            out.clear();
+            process_line(transformation, line, nLineNumber, out);
+            fputs(out.c_str(), stdout);
+            fflush(stdout);
+        }
+        return;
+    }
+
+    /* Multi-threaded processing: read the input by chunks of lines, and */
+    /* split each chunk in as many ranges as threads, each transformed   */
+    /* with its own clone of the transformation, writing its output to   */
+    /* its own buffer. The buffers are then written in order.            */
+    const int nThreads = static_cast<int>(workers.size()) + 1;
+    constexpr size_t LINES_PER_THREAD = 10000;
+    const size_t chunkSize = LINES_PER_THREAD * nThreads;
+    std::vector<std::string> lines;
+    std::vector<std::string> outs(nThreads);
+    bool eof = false;
+    while (!eof) {
+        lines.clear();
+        while (lines.size() < chunkSize) {
+            if (!read_line(fid, line)) {
+                eof = true;
+                break;
             }
+            lines.emplace_back(line);
         }
+        const int firstLineNumber = nLineNumber + 1;
+        nLineNumber += static_cast<int>(lines.size());
+
+        process_ranges_in_threads(
+            lines.size(), nThreads,
+            [&lines, &outs, firstLineNumber](int iRange, size_t start,
+                                             size_t count) {
+                PJ *P = iRange == 0 ? transformation : workers[iRange - 1];
+                std::string &rangeOut = outs[iRange];
+                for (size_t i = start; i < start + count; i++) {
+                    process_line(P, &lines[i][0],
+                                 firstLineNumber + static_cast<int>(i),
+                                 rangeOut);
+                }
+            });
 
-        putchar(' ');
-        if (oform != nullptr)
-            limited_fprintf_for_number(stdout, oform, z);
-        else
-            printf("%.3f", z);
-        if (s)
-            printf("%s", s);
-        else
-            printf("\n");
+        for (auto &rangeOut : outs) {
+            fwrite(rangeOut.data(), 1, rangeOut.size(), stdout);
+            rangeOut.clear();
+        }
         fflush(stdout);
     }
 }
@@ -435,6 +499,7 @@ int main(int argc, char **argv) {
     bool promoteTo3D = false;
     std::string sourceEpoch;
     std::string targetEpoch;
+    int nThreads = 1;
 
     /* process run line arguments */
     while (--argc > 0) { /* collect run line arguments */
@@ -534,6 +599,18 @@ int main(int argc, char **argv) {
                 std::exit(1);
             }
             targetEpoch = *argv;
+        } else if (strcmp(*argv, "--threads") == 0) {
+            ++argv;
+            --argc;
+            if (argc == 0) {
+                emess(1, "missing argument for --threads");
+                std::exit(1);
+            }
+            nThreads = atoi(*argv);
+            if (nThreads < 1) {
+                emess(1, "invalid number of threads: %s", *argv);
+                std::exit(1);
+            }
         } else if (**argv == '-') {
             for (arg = *argv;;) {
                 switch (*++arg) {
@@ -637,6 +714,13 @@ int main(int argc, char **argv) {
                         goto noargument;
                     oform = *++argv;
                     continue;
+                case 'j': /* number of threads */
+                    if (--argc <= 0)
+                        goto noargument;
+                    nThreads = atoi(*++argv);
+                    if (nThreads < 1)
+                        emess(1, "invalid number of threads: %s", *argv);
+                    continue;
                 case 'r': /* reverse input */
                     reversein = 1;
                     continue;
@@ -1020,6 +1104,9 @@ int main(int argc, char **argv) {
     if (!destIsLongLat && !oform)
         oform = "%.2f";
 
+    if (nThreads > 1)
+        workers = clone_for_threads(transformation, nThreads - 1);
+
     /* process input file list */
     for (; eargc--; ++eargv) {
         if (**eargv == '-') {
@@ -1039,6 +1126,7 @@ int main(int argc, char **argv) {
         emess_dat.File_name = nullptr;
     }
 
+    destroy_clones_for_threads(workers);
     proj_destroy(transformation);
 
     proj_cleanup();
@@ -27,10 +27,14 @@
  ****************************************************************************/
 
 #include "utils.h"
+#include "proj_internal.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+#include <exception>
+#include <thread>
+
 bool validate_form_string_for_numbers(const char *formatString) {
     /* Only accepts '%[+]?[number]?[.]?[number]?[e|E|f|F|g|G]' */
     bool valid = true;
@@ -63,18 +67,18 @@ bool validate_form_string_for_numbers(const char *formatString) {
 #define MY_FPRINTF0(fmt0, fmt, ...)                                            \
     do {                                                                       \
         if (*ptr == 'e')                                                       \
-            fprintf(f, "%" fmt0 fmt "e", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "e", __VA_ARGS__);             \
         else if (*ptr == 'E')                                                  \
-            fprintf(f, "%" fmt0 fmt "E", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "E", __VA_ARGS__);             \
         else if (*ptr == 'f')                                                  \
-            fprintf(f, "%" fmt0 fmt "f", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "f", __VA_ARGS__);             \
         else if (*ptr == 'g')                                                  \
-            fprintf(f, "%" fmt0 fmt "g", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "g", __VA_ARGS__);             \
         else if (*ptr == 'G')                                                  \
-            fprintf(f, "%" fmt0 fmt "G", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "G", __VA_ARGS__);             \
         else {                                                                 \
             fprintf(stderr, "Wrong formatString '%s'\n", formatString);        \
-            return;                                                            \
+            return false;                                                      \
         }                                                                      \
         ++ptr;                                                                 \
     } while (0)
@@ -82,20 +86,20 @@ bool validate_form_string_for_numbers(const char *formatString) {
 #define MY_FPRINTF0(fmt0, fmt, ...)                                            \
     do {                                                                       \
         if (*ptr == 'e')                                                       \
-            fprintf(f, "%" fmt0 fmt "e", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "e", __VA_ARGS__);             \
         else if (*ptr == 'E')                                                  \
-            fprintf(f, "%" fmt0 fmt "E", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "E", __VA_ARGS__);             \
         else if (*ptr == 'f')                                                  \
-            fprintf(f, "%" fmt0 fmt "f", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "f", __VA_ARGS__);             \
         else if (*ptr == 'F')                                                  \
-            fprintf(f, "%" fmt0 fmt "F", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "F", __VA_ARGS__);             \
         else if (*ptr == 'g')                                                  \
-            fprintf(f, "%" fmt0 fmt "g", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "g", __VA_ARGS__);             \
         else if (*ptr == 'G')                                                  \
-            fprintf(f, "%" fmt0 fmt "G", __VA_ARGS__);                         \
+            snprintf(buf, bufSize, "%" fmt0 fmt "G", __VA_ARGS__);             \
         else {                                                                 \
             fprintf(stderr, "Wrong formatString '%s'\n", formatString);        \
-            return;                                                            \
+            return false;                                                      \
         }                                                                      \
         ++ptr;                                                                 \
     } while (0)
@@ -121,15 +125,16 @@ static int parseInt(const char *&ptr) {
     return val;
 }
 
-// This function is a limited version of fprintf(f, formatString, val) where
-// formatString is a subset of formatting strings accepted by
-// validate_form_string_for_numbers().
+// This function is a limited version of
+// snprintf(buf, bufSize, formatString, val) where formatString is a subset of
+// formatting strings accepted by validate_form_string_for_numbers().
 // This methods makes CodeQL cpp/tainted-format-string check happy.
-void limited_fprintf_for_number(FILE *f, const char *formatString, double val) {
+bool limited_snprintf_for_number(char *buf, size_t bufSize,
+                                 const char *formatString, double val) {
     const char *ptr = formatString;
     if (*ptr != '%') {
         fprintf(stderr, "Wrong formatString '%s'\n", formatString);
-        return;
+        return false;
     }
     ++ptr;
     const bool withPlus = (*ptr == '+');
@@ -141,7 +146,7 @@ void limited_fprintf_for_number(FILE *f, const char *formatString, double val) {
         const int w = parseInt(ptr);
         if (w < 0 || *ptr == 0) {
             fprintf(stderr, "Wrong formatString '%s'\n", formatString);
-            return;
+            return false;
         }
         if (*ptr == '.') {
             ++ptr;
@@ -149,7 +154,7 @@ void limited_fprintf_for_number(FILE *f, const char *formatString, double val) {
                 const int p = parseInt(ptr);
                 if (p < 0 || *ptr == 0) {
                     fprintf(stderr, "Wrong formatString '%s'\n", formatString);
-                    return;
+                    return false;
                 }
                 if (isLeadingZero) {
                     MY_FPRINTF("0*.*", w, p, val);
@@ -176,7 +181,7 @@ void limited_fprintf_for_number(FILE *f, const char *formatString, double val) {
             const int p = parseInt(ptr);
             if (p < 0 || *ptr == 0) {
                 fprintf(stderr, "Wrong formatString '%s'\n", formatString);
-                return;
+                return false;
             }
             MY_FPRINTF(".*", p, val);
         } else {
@@ -187,6 +192,72 @@ void limited_fprintf_for_number(FILE *f, const char *formatString, double val) {
     }
     if (*ptr != 0) {
         fprintf(stderr, "Wrong formatString '%s'\n", formatString);
+        return false;
+    }
+    return true;
+}
+
+// This function is a limited version of fprintf(f, formatString, val). See
+// limited_snprintf_for_number().
+void limited_fprintf_for_number(FILE *f, const char *formatString, double val) {
+    // Large enough for a width and a precision of up to 1000
+    char buf[2100];
+    if (limited_snprintf_for_number(buf, sizeof(buf), formatString, val))
+        fputs(buf, f);
+}
+
+// Create count clones of P, each one attached to its own clone of the context
+// of P, so that they can be used concurrently by worker threads. Fewer clones
+// are returned if P cannot be cloned.
+std::vector<PJ *> clone_for_threads(PJ *P, int count) {
+    std::vector<PJ *> clones;
+    for (int i = 0; i < count; i++) {
+        PJ_CONTEXT *ctx = proj_context_clone(P->ctx);
+        if (ctx == nullptr)
+            break;
+        PJ *clone = proj_clone(ctx, P);
+        if (clone == nullptr) {
+            proj_context_destroy(ctx);
+            break;
+        }
+        clones.push_back(clone);
+    }
+    return clones;
+}
+
+// Destroy the clones returned by clone_for_threads() and their contexts.
+void destroy_clones_for_threads(std::vector<PJ *> &clones) {
+    for (PJ *clone : clones) {
+        PJ_CONTEXT *ctx = clone->ctx;
+        proj_destroy(clone);
+        proj_context_destroy(ctx);
+    }
+    clones.clear();
+}
+
+// Call processRange(iRange, start, count) on nRanges consecutive ranges
+// covering [0, n). Range 0 is processed by the calling thread, and the other
+// ones each by their own thread.
+void process_ranges_in_threads(
+    size_t n, int nRanges,
+    const std::function<void(int, size_t, size_t)> &processRange) {
+    if (nRanges <= 1 || n < static_cast<size_t>(nRanges)) {
+        processRange(0, 0, n);
         return;
     }
+    const size_t countPerRange = n / nRanges;
+    std::vector<std::thread> threads;
+    for (int i = 1; i < nRanges; i++) {
+        const size_t start = i * countPerRange;
+        const size_t count = (i + 1 == nRanges) ? n - start : countPerRange;
+        try {
+            threads.emplace_back(processRange, i, start, count);
+        } catch (const std::exception &) {
+            // Thread creation failed: process the range here
+            processRange(i, start, count);
+        }
+    }
+    processRange(0, 0, countPerRange);
+    for (auto &thread : threads)
+        thread.join();
 }
@@ -28,6 +28,22 @@
 
 #include <stdio.h>
 
+#include <functional>
+#include <vector>
+
+#include "proj.h"
+
 bool validate_form_string_for_numbers(const char *formatString);
 
+bool limited_snprintf_for_number(char *buf, size_t bufSize,
+                                 const char *formatString, double val);
+
 void limited_fprintf_for_number(FILE *f, const char *formatString, double val);
+
+std::vector<PJ *> clone_for_threads(PJ *P, int count);
+
+void destroy_clones_for_threads(std::vector<PJ *> &clones);
+
+void process_ranges_in_threads(
+    size_t n, int nRanges,
+    const std::function<void(int, size_t, size_t)> &processRange);
@@ -154,6 +154,36 @@ static void pj_axisswap_reverse_4d(PJ_COORD &coo, PJ *P) {
     coo = out;
 }
 
+/* Permutation matrix of the swap, as long as the time axis is untouched */
+static bool pj_axisswap_get_affine(const PJ *P, PJ_DIRECTION dir,
+                                   double m[3][4]) {
+    const struct pj_axisswap_data *Q =
+        (const struct pj_axisswap_data *)P->opaque;
+    unsigned int i, n;
+
+    if (P->fwd4d == pj_axisswap_forward_4d) {
+        if (Q->axis[3] != 3 || Q->sign[3] != 1)
+            return false;
+        n = 3;
+    } else if (P->fwd3d != nullptr)
+        n = 3;
+    else
+        n = 2;
+
+    for (i = 0; i < 3; i++)
+        for (unsigned int j = 0; j < 4; j++)
+            m[i][j] = 0.0;
+    for (i = n; i < 3; i++)
+        m[i][i] = 1.0;
+    for (i = 0; i < n; i++) {
+        if (dir == PJ_INV)
+            m[Q->axis[i]][i] = Q->sign[i];
+        else
+            m[i][Q->axis[i]] = Q->sign[i];
+    }
+    return true;
+}
+
 /***********************************************************************/
 PJ *PJ_CONVERSION(axisswap, 0) {
     /***********************************************************************/
@@ -287,6 +317,7 @@ PJ *PJ_CONVERSION(axisswap, 0) {
         proj_log_error(P, _("axisswap: bad axis order"));
         return pj_default_destructor(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
     }
+    P->get_affine = pj_axisswap_get_affine;
 
     if (pj_param(P->ctx, P->params, "tangularunits").i) {
         P->left = PJ_IO_UNITS_RADIANS;
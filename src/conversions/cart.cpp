@@ -238,6 +238,162 @@ static PJ_LPZ geodetic(PJ_XYZ cart, PJ *P) {
     return lpz;
 }
 
+/*********************************************************************
+    Batch versions of cartesian() and geodetic().
+
+    Coordinates are processed CART_BATCH_LANES at a time: the
+    trigonometric functions are evaluated point by point, while the rest
+    of the computation is done lane-wise in fixed-length loops that the
+    compiler can vectorize. Operations are carried out in the same order
+    as in the point-wise functions, so that both give the same results.
+**********************************************************************/
+
+#define CART_BATCH_LANES 8
+
+/* Gather up to CART_BATCH_LANES points not already failed, starting at
+   index i, into v0[], v1[] and v2[], padding unused lanes with zeros.
+   Returns the number of gathered points, and updates i */
+static int gather_lanes(const PJ_COORD *coo, size_t n, size_t &i,
+                        size_t *idx, double *v0, double *v1, double *v2) {
+    int m = 0;
+    for (; i < n && m < CART_BATCH_LANES; i++) {
+        if (HUGE_VAL == coo[i].v[0])
+            continue;
+        idx[m] = i;
+        v0[m] = coo[i].v[0];
+        v1[m] = coo[i].v[1];
+        v2[m] = coo[i].v[2];
+        m++;
+    }
+    for (int j = m; j < CART_BATCH_LANES; j++)
+        v0[j] = v1[j] = v2[j] = 0;
+    return m;
+}
+
+static void scatter_lanes(PJ_COORD *coo, int m, const size_t *idx,
+                          const double *v0, const double *v1,
+                          const double *v2) {
+    for (int j = 0; j < m; j++) {
+        PJ_COORD &c = coo[idx[j]];
+        c.v[0] = v0[j];
+        c.v[1] = v1[j];
+        c.v[2] = v2[j];
+    }
+}
+
+static void cartesian_batch(PJ_COORD *coo, size_t n, int *, PJ *P) {
+    /*********************************************************************/
+    constexpr int L = CART_BATCH_LANES;
+    size_t idx[L];
+    double lam[L], phi[L], h[L], cosphi[L], sinphi[L], coslam[L], sinlam[L];
+    double N[L], x[L], y[L], z[L];
+
+    size_t i = 0;
+    while (i < n) {
+        const int m = gather_lanes(coo, n, i, idx, lam, phi, h);
+        if (m == 0)
+            break;
+
+        for (int j = 0; j < L; j++) {
+            cosphi[j] = cos(phi[j]);
+            sinphi[j] = sin(phi[j]);
+            coslam[j] = cos(lam[j]);
+            sinlam[j] = sin(lam[j]);
+        }
+
+        if (P->es == 0) {
+            for (int j = 0; j < L; j++)
+                N[j] = P->a;
+        } else {
+            for (int j = 0; j < L; j++)
+                N[j] = P->a / sqrt(1 - P->es * sinphi[j] * sinphi[j]);
+        }
+
+        for (int j = 0; j < L; j++) {
+            x[j] = (N[j] + h[j]) * cosphi[j] * coslam[j];
+            y[j] = (N[j] + h[j]) * cosphi[j] * sinlam[j];
+            z[j] = (N[j] * (1 - P->es) + h[j]) * sinphi[j];
+        }
+
+        scatter_lanes(coo, m, idx, x, y, z);
+    }
+}
+
+static void geodetic_batch(PJ_COORD *coo, size_t n, int *, PJ *P) {
+    /*********************************************************************/
+    constexpr int L = CART_BATCH_LANES;
+    size_t idx[L];
+    double x[L], y[L], z[L], x_div_a[L], y_div_a[L], p_div_a[L];
+    double y_phi[L], x_phi[L], cosphi[L], sinphi[L];
+    double lam[L], phi[L], h[L];
+
+    const double b_div_a = 1 - P->f; // = P->b / P->a
+
+    size_t i = 0;
+    while (i < n) {
+        const int m = gather_lanes(coo, n, i, idx, x, y, z);
+        if (m == 0)
+            break;
+
+        for (int j = 0; j < L; j++) {
+            // Normalize (x,y,z) to the unit sphere/ellipsoid.
+#if (defined(__i386__) && !defined(__SSE__)) || defined(_M_IX86)
+            x_div_a[j] = x[j] / P->a;
+            y_div_a[j] = y[j] / P->a;
+            const double z_div_a = z[j] / P->a;
+#else
+            x_div_a[j] = x[j] * P->ra;
+            y_div_a[j] = y[j] * P->ra;
+            const double z_div_a = z[j] * P->ra;
+#endif
+            p_div_a[j] =
+                sqrt(x_div_a[j] * x_div_a[j] + y_div_a[j] * y_div_a[j]);
+
+            const double p_div_a_b_div_a = p_div_a[j] * b_div_a;
+            const double norm =
+                sqrt(z_div_a * z_div_a + p_div_a_b_div_a * p_div_a_b_div_a);
+            const double inv_norm = 1.0 / norm;
+            const double c = norm != 0 ? p_div_a_b_div_a * inv_norm : 1;
+            const double s = norm != 0 ? z_div_a * inv_norm : 0;
+
+            y_phi[j] = z_div_a + P->e2s * b_div_a * s * s * s;
+            x_phi[j] = p_div_a[j] - P->es * c * c * c;
+            const double norm_phi =
+                sqrt(y_phi[j] * y_phi[j] + x_phi[j] * x_phi[j]);
+            const double inv_norm_phi = 1.0 / norm_phi;
+            cosphi[j] = norm_phi != 0 ? x_phi[j] * inv_norm_phi : 1;
+            sinphi[j] = norm_phi != 0 ? y_phi[j] * inv_norm_phi : 0;
+        }
+
+        for (int j = 0; j < L; j++) {
+            if (x_phi[j] <= 0) {
+                // see geodetic()
+                phi[j] = z[j] >= 0 ? M_HALFPI : -M_HALFPI;
+                cosphi[j] = 0;
+                sinphi[j] = z[j] >= 0 ? 1 : -1;
+            } else {
+                phi[j] = atan(y_phi[j] / x_phi[j]);
+            }
+            lam[j] = atan2(y_div_a[j], x_div_a[j]);
+        }
+
+        for (int j = 0; j < L; j++) {
+            if (cosphi[j] < 1e-6) {
+                /* poleward of 89.99994 deg, see geodetic() */
+                const double r =
+                    geocentric_radius(P->a, b_div_a, cosphi[j], sinphi[j]);
+                h[j] = fabs(z[j]) - r;
+            } else {
+                const double N =
+                    normal_radius_of_curvature(P->a, P->es, sinphi[j]);
+                h[j] = P->a * p_div_a[j] / cosphi[j] - N;
+            }
+        }
+
+        scatter_lanes(coo, m, idx, lam, phi, h);
+    }
+}
+
 /* In effect, 2 cartesian coordinates of a point on the ellipsoid. Rather
  * pointless, but... */
 static PJ_XY cart_forward(PJ_LP lp, PJ *P) {
@@ -266,6 +422,8 @@ PJ *PJ_CONVERSION(cart, 1) {
     /*********************************************************************/
     P->fwd3d = cartesian;
     P->inv3d = geodetic;
+    P->fwd4d_batch = cartesian_batch;
+    P->inv4d_batch = geodetic_batch;
     P->fwd = cart_forward;
     P->inv = cart_reverse;
     P->left = PJ_IO_UNITS_RADIANS;
@@ -6,9 +6,17 @@ PROJ_HEAD(noop, "No operation");
 
 static void noop(PJ_COORD &, PJ *) {}
 
+static bool noop_get_affine(const PJ *, PJ_DIRECTION, double m[3][4]) {
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 4; j++)
+            m[i][j] = (i == j) ? 1.0 : 0.0;
+    return true;
+}
+
 PJ *PJ_CONVERSION(noop, 0) {
     P->fwd4d = noop;
     P->inv4d = noop;
+    P->get_affine = noop_get_affine;
     P->left = PJ_IO_UNITS_WHATEVER;
     P->right = PJ_IO_UNITS_WHATEVER;
     return P;
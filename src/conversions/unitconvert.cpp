@@ -391,6 +391,28 @@ static void reverse_4d(PJ_COORD &coo, PJ *P) {
         coo.xyzt.t = time_units[Q->t_in_id].t_out(coo.xyzt.t);
 }
 
+/***********************************************************************/
+static bool get_affine(const PJ *P, PJ_DIRECTION dir, double m[3][4]) {
+    /************************************************************************
+        Affine equivalent of the conversion, when time units are untouched
+    ************************************************************************/
+    const struct pj_opaque_unitconvert *Q =
+        (const struct pj_opaque_unitconvert *)P->opaque;
+
+    if (Q->t_in_id >= 0 || Q->t_out_id >= 0)
+        return false;
+
+    const double xy_factor = dir == PJ_INV ? 1 / Q->xy_factor : Q->xy_factor;
+    const double z_factor = dir == PJ_INV ? 1 / Q->z_factor : Q->z_factor;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 4; j++)
+            m[i][j] = 0.0;
+    m[0][0] = xy_factor;
+    m[1][1] = xy_factor;
+    m[2][2] = z_factor;
+    return true;
+}
+
 /***********************************************************************/
 static double get_unit_conversion_factor(const char *name, int *p_is_linear,
                                          const char **p_normalized_name) {
@@ -458,6 +480,7 @@ PJ *PJ_CONVERSION(unitconvert, 0) {
     P->inv3d = reverse_3d;
     P->fwd = forward_2d;
     P->inv = reverse_2d;
+    P->get_affine = get_affine;
 
     P->left = PJ_IO_UNITS_WHATEVER;
     P->right = PJ_IO_UNITS_WHATEVER;
@@ -28,6 +28,7 @@
 
 #define FROM_PROJ_CPP
 
+#include "filemanager.hpp"
 #include "proj.h"
 #include "proj_internal.h"
 #include <math.h>
@@ -477,6 +478,100 @@ static const char *getOptionValue(const char *option,
 }
 //! @endcond
 
+static PJ *create_crs_to_crs_from_pj_uncached(
+    PJ_CONTEXT *ctx, const PJ *source_crs, const PJ *target_crs,
+    const PJ_AREA *area, const char *authority, double accuracy,
+    bool allowBallparkTransformations, bool forceOver,
+    bool warnIfBestTransformationNotAvailable,
+    bool errorIfBestTransformationNotAvailable);
+
+/*****************************************************************************/
+static std::string crs_to_crs_cache_key(
+    PJ_CONTEXT *ctx, const PJ *source_crs, const PJ *target_crs,
+    const PJ_AREA *area, const char *authority, double accuracy,
+    bool allowBallparkTransformations, bool forceOver,
+    bool warnIfBestTransformationNotAvailable,
+    bool errorIfBestTransformationNotAvailable) {
+    /*****************************************************************************/
+
+    // Everything the result of proj_create_crs_to_crs_from_pj() depends on,
+    // except the set of installed grids.
+    std::string key("PROJ=");
+    key += toString(PROJ_VERSION_MAJOR);
+    key += '.';
+    key += toString(PROJ_VERSION_MINOR);
+    key += '.';
+    key += toString(PROJ_VERSION_PATCH);
+
+    const char *dbPath = proj_context_get_database_path(ctx);
+    if (!dbPath) {
+        return std::string();
+    }
+    key += "\nDATABASE=";
+    key += dbPath;
+    for (const char *metadataKey : {"DATABASE.LAYOUT.VERSION.MAJOR",
+                                    "DATABASE.LAYOUT.VERSION.MINOR",
+                                    "EPSG.VERSION", "PROJ_DATA.VERSION"}) {
+        const char *value =
+            proj_context_get_database_metadata(ctx, metadataKey);
+        key += '\n';
+        key += metadataKey;
+        key += '=';
+        key += value ? value : "";
+    }
+
+    key += "\nPROJ_DATA=";
+    key += NS_PROJ::FileManager::getProjDataEnvVar(ctx);
+    key += "\nSEARCH_PATHS=";
+    for (const auto &path : ctx->search_paths) {
+        key += path;
+        key += ';';
+    }
+    key += "\nNETWORK=";
+    key += proj_context_is_network_enabled(ctx) ? '1' : '0';
+
+    key += "\nAUTHORITY=";
+    key += authority ? authority : "";
+    key += "\nACCURACY=";
+    key += toString(accuracy, 17);
+    key += "\nALLOW_BALLPARK=";
+    key += allowBallparkTransformations ? '1' : '0';
+    key += "\nFORCE_OVER=";
+    key += forceOver ? '1' : '0';
+    key += "\nWARN_IF_BEST_NOT_AVAILABLE=";
+    key += warnIfBestTransformationNotAvailable ? '1' : '0';
+    key += "\nERROR_IF_BEST_NOT_AVAILABLE=";
+    key += errorIfBestTransformationNotAvailable ? '1' : '0';
+
+    if (area && area->bbox_set) {
+        key += "\nAREA=";
+        key += toString(area->west_lon_degree, 17);
+        key += ',';
+        key += toString(area->south_lat_degree, 17);
+        key += ',';
+        key += toString(area->east_lon_degree, 17);
+        key += ',';
+        key += toString(area->north_lat_degree, 17);
+        key += ',';
+        key += area->name;
+    }
+
+    const char *const jsonOptions[] = {"MULTILINE=NO", nullptr};
+    const char *sourceJSON = proj_as_projjson(ctx, source_crs, jsonOptions);
+    if (!sourceJSON) {
+        return std::string();
+    }
+    key += "\nSOURCE=";
+    key += sourceJSON;
+    const char *targetJSON = proj_as_projjson(ctx, target_crs, jsonOptions);
+    if (!targetJSON) {
+        return std::string();
+    }
+    key += "\nTARGET=";
+    key += targetJSON;
+    return key;
+}
+
 /*****************************************************************************/
 PJ *proj_create_crs_to_crs_from_pj(PJ_CONTEXT *ctx, const PJ *source_crs,
                                    const PJ *target_crs, PJ_AREA *area,
@@ -541,6 +636,63 @@ PJ *proj_create_crs_to_crs_from_pj(PJ_CONTEXT *ctx, const PJ *source_crs,
         }
     }
 
+    std::string cacheKey;
+    if (pj_context_get_crs_to_crs_cache_is_enabled(ctx)) {
+        cacheKey = crs_to_crs_cache_key(
+            ctx, source_crs, target_crs, area, authority, accuracy,
+            allowBallparkTransformations, forceOver,
+            warnIfBestTransformationNotAvailable,
+            errorIfBestTransformationNotAvailable);
+        if (!cacheKey.empty()) {
+            ctx->forceOver = forceOver;
+            PJ *P = pj_crs_to_crs_cache_get(ctx, cacheKey);
+            ctx->forceOver = false;
+            if (P) {
+                P->over = forceOver;
+                P->errorIfBestTransformationNotAvailable =
+                    errorIfBestTransformationNotAvailable;
+                P->warnIfBestTransformationNotAvailable =
+                    warnIfBestTransformationNotAvailable;
+                P->skipNonInstantiable = warnIfBestTransformationNotAvailable;
+                for (auto &op : P->alternativeCoordinateOperations) {
+                    op.pj->over = forceOver;
+                    op.pj->errorIfBestTransformationNotAvailable =
+                        errorIfBestTransformationNotAvailable;
+                    op.pj->warnIfBestTransformationNotAvailable =
+                        warnIfBestTransformationNotAvailable;
+                }
+                return P;
+            }
+        }
+    }
+
+    PJ *P = create_crs_to_crs_from_pj_uncached(
+        ctx, source_crs, target_crs, area, authority, accuracy,
+        allowBallparkTransformations, forceOver,
+        warnIfBestTransformationNotAvailable,
+        errorIfBestTransformationNotAvailable);
+
+    // A single operation that is not instantiable is only returned after
+    // a warning, which a cached result would not emit again.
+    if (P && !cacheKey.empty() &&
+        (!P->alternativeCoordinateOperations.empty() ||
+         !(errorIfBestTransformationNotAvailable ||
+           warnIfBestTransformationNotAvailable) ||
+         proj_coordoperation_is_instantiable(ctx, P))) {
+        pj_crs_to_crs_cache_put(ctx, cacheKey, P);
+    }
+    return P;
+}
+
+/*****************************************************************************/
+static PJ *create_crs_to_crs_from_pj_uncached(
+    PJ_CONTEXT *ctx, const PJ *source_crs, const PJ *target_crs,
+    const PJ_AREA *area, const char *authority, double accuracy,
+    bool allowBallparkTransformations, bool forceOver,
+    bool warnIfBestTransformationNotAvailable,
+    bool errorIfBestTransformationNotAvailable) {
+    /*****************************************************************************/
+
     auto operation_ctx = proj_create_operation_factory_context(ctx, authority);
     if (!operation_ctx) {
         return nullptr;
@@ -0,0 +1,654 @@
+/******************************************************************************
+ * Project:  PROJ
+ * Purpose:  Persistent cache of proj_create_crs_to_crs() results
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef FROM_PROJ_CPP
+#define FROM_PROJ_CPP
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "proj.h"
+#include "proj/common.hpp"
+#include "proj/internal/internal.hpp"
+#include "proj/metadata.hpp"
+#include "proj/util.hpp"
+#include "proj_internal.h"
+#include "sqlite3_utils.hpp"
+
+#include "iso19111/operation/coordinateoperation_internal.hpp"
+
+#include <sqlite3.h>
+
+using namespace NS_PROJ::internal;
+
+NS_PROJ_START
+
+//! @cond Doxygen_Suppress
+
+// ---------------------------------------------------------------------------
+
+// Maximum number of proj_create_crs_to_crs() results kept in the cache.
+// Oldest entries are evicted first.
+constexpr int CRS_TO_CRS_CACHE_MAX_ENTRIES = 10000;
+
+// ---------------------------------------------------------------------------
+
+class CrsToCrsCache {
+    PJ_CONTEXT *ctx_ = nullptr;
+    std::string path_{};
+    sqlite3 *hDB_ = nullptr;
+    std::unique_ptr<SQLite3VFS> vfs_{};
+
+    explicit CrsToCrsCache(PJ_CONTEXT *ctx, const std::string &path);
+
+    bool initialize();
+
+    CrsToCrsCache(const CrsToCrsCache &) = delete;
+    CrsToCrsCache &operator=(const CrsToCrsCache &) = delete;
+
+  public:
+    static std::unique_ptr<CrsToCrsCache> open(PJ_CONTEXT *ctx);
+    ~CrsToCrsCache();
+
+    std::unique_ptr<SQLiteStatement> prepare(const char *sql);
+    bool exec(const char *sql);
+    sqlite3 *handle() { return hDB_; }
+    void closeAndUnlink();
+};
+
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<CrsToCrsCache> CrsToCrsCache::open(PJ_CONTEXT *ctx) {
+    const auto cachePath = pj_context_get_crs_to_crs_cache_filename(ctx);
+    if (cachePath.empty()) {
+        return nullptr;
+    }
+
+    auto cache =
+        std::unique_ptr<CrsToCrsCache>(new CrsToCrsCache(ctx, cachePath));
+    if (!cache->initialize())
+        cache.reset();
+    return cache;
+}
+
+// ---------------------------------------------------------------------------
+
+CrsToCrsCache::CrsToCrsCache(PJ_CONTEXT *ctx, const std::string &path)
+    : ctx_(ctx), path_(path) {}
+
+// ---------------------------------------------------------------------------
+
+CrsToCrsCache::~CrsToCrsCache() {
+    if (hDB_) {
+        sqlite3_close(hDB_);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+static const char *crs_to_crs_cache_structure_sql =
+    "CREATE TABLE IF NOT EXISTS crs_to_crs_result("
+    " id                  INTEGER PRIMARY KEY AUTOINCREMENT CHECK (id > 0),"
+    " cache_key           TEXT UNIQUE NOT NULL,"
+    " is_single_operation INTEGER NOT NULL"
+    ");"
+    "CREATE TABLE IF NOT EXISTS crs_to_crs_operation("
+    " result_id                 INTEGER NOT NULL,"
+    " idx                       INTEGER NOT NULL,"
+    " idx_in_original_list      INTEGER NOT NULL,"
+    " pipeline                  TEXT NOT NULL,"
+    " name                      TEXT NOT NULL,"
+    " accuracy                  REAL NOT NULL,"
+    " pseudo_area               REAL NOT NULL,"
+    " area_name                 TEXT NOT NULL,"
+    " minx_src                  REAL NOT NULL,"
+    " miny_src                  REAL NOT NULL,"
+    " maxx_src                  REAL NOT NULL,"
+    " maxy_src                  REAL NOT NULL,"
+    " minx_dst                  REAL NOT NULL,"
+    " miny_dst                  REAL NOT NULL,"
+    " maxx_dst                  REAL NOT NULL,"
+    " maxy_dst                  REAL NOT NULL,"
+    " src_is_lon_lat_degree     INTEGER NOT NULL,"
+    " src_is_lat_lon_degree     INTEGER NOT NULL,"
+    " dst_is_lon_lat_degree     INTEGER NOT NULL,"
+    " dst_is_lat_lon_degree     INTEGER NOT NULL,"
+    " src_geocentric_to_lon_lat TEXT,"
+    " dst_geocentric_to_lon_lat TEXT,"
+    " coordinate_epoch          REAL,"
+    " CONSTRAINT fk_operation_result FOREIGN KEY (result_id) "
+    "REFERENCES crs_to_crs_result(id)"
+    ");"
+    "CREATE INDEX IF NOT EXISTS idx_crs_to_crs_operation ON "
+    "crs_to_crs_operation(result_id, idx);";
+
+bool CrsToCrsCache::initialize() {
+    std::string vfsName;
+    if (ctx_->custom_sqlite3_vfs_name.empty()) {
+        vfs_ = SQLite3VFS::create(true, false, false);
+        if (vfs_ == nullptr) {
+            return false;
+        }
+        vfsName = vfs_->name();
+    } else {
+        vfsName = ctx_->custom_sqlite3_vfs_name;
+    }
+    sqlite3_open_v2(path_.c_str(), &hDB_,
+                    SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
+                    vfsName.c_str());
+    if (!hDB_) {
+        pj_log(ctx_, PJ_LOG_DEBUG, "Cannot open %s", path_.c_str());
+        return false;
+    }
+
+    // Several processes may share the cache: wait a bit for the lock of
+    // another writer to be released rather than failing immediately.
+    sqlite3_busy_timeout(hDB_, 1000);
+
+    if (!exec(crs_to_crs_cache_structure_sql)) {
+        sqlite3_close(hDB_);
+        hDB_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<SQLiteStatement> CrsToCrsCache::prepare(const char *sql) {
+    sqlite3_stmt *hStmt = nullptr;
+    sqlite3_prepare_v2(hDB_, sql, -1, &hStmt, nullptr);
+    if (!hStmt) {
+        pj_log(ctx_, PJ_LOG_DEBUG, "%s", sqlite3_errmsg(hDB_));
+        return nullptr;
+    }
+    return std::unique_ptr<SQLiteStatement>(new SQLiteStatement(hStmt));
+}
+
+// ---------------------------------------------------------------------------
+
+bool CrsToCrsCache::exec(const char *sql) {
+    if (sqlite3_exec(hDB_, sql, nullptr, nullptr, nullptr) != SQLITE_OK) {
+        pj_log(ctx_, PJ_LOG_DEBUG, "%s", sqlite3_errmsg(hDB_));
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+void CrsToCrsCache::closeAndUnlink() {
+    sqlite3_close(hDB_);
+    hDB_ = nullptr;
+    if (vfs_) {
+        vfs_->raw()->xDelete(vfs_->raw(), path_.c_str(), 0);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+/** Instantiate a coordinate operation from its PROJ pipeline, keeping the
+ * name and accuracy of the operation it was exported from. */
+static PJ *createCachedOperation(PJ_CONTEXT *ctx, const char *pipeline,
+                                 const std::string &name, double accuracy) {
+    try {
+        util::PropertyMap props;
+        if (!name.empty()) {
+            props.set(common::IdentifiedObject::NAME_KEY, name);
+        }
+        std::vector<metadata::PositionalAccuracyNNPtr> accuracies;
+        if (accuracy >= 0) {
+            accuracies.emplace_back(
+                metadata::PositionalAccuracy::create(toString(accuracy)));
+        }
+        return pj_obj_create(ctx, operation::PROJBasedOperation::create(
+                                      props, pipeline, nullptr, nullptr,
+                                      accuracies));
+    } catch (const std::exception &) {
+        return nullptr;
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+struct CachedOperation {
+    int idxInOriginalList = 0;
+    std::string pipeline{};
+    std::string name{};
+    double accuracy = -1.0;
+    double pseudoArea = 0.0;
+    std::string areaName{};
+    double bbox[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    bool srcIsLonLatDegree = false;
+    bool srcIsLatLonDegree = false;
+    bool dstIsLonLatDegree = false;
+    bool dstIsLatLonDegree = false;
+    std::string srcGeocentricToLonLat{};
+    std::string dstGeocentricToLonLat{};
+    bool hasCoordinateEpoch = false;
+    double coordinateEpoch = 0.0;
+};
+
+// ---------------------------------------------------------------------------
+
+static bool exportToCache(PJ_CONTEXT *ctx, const PJ *op,
+                          std::string &pipelineOut) {
+    const char *pipeline = proj_as_proj_string(ctx, op, PJ_PROJ_5, nullptr);
+    if (!pipeline) {
+        return false;
+    }
+    pipelineOut = pipeline;
+    return true;
+}
+
+//! @endcond
+
+NS_PROJ_END
+
+using namespace NS_PROJ;
+
+//! @cond Doxygen_Suppress
+
+// ---------------------------------------------------------------------------
+
+bool pj_context_get_crs_to_crs_cache_is_enabled(PJ_CONTEXT *ctx) {
+    pj_load_ini(ctx);
+    return ctx->crsToCrsCache.enabled;
+}
+
+// ---------------------------------------------------------------------------
+
+std::string pj_context_get_crs_to_crs_cache_filename(PJ_CONTEXT *ctx) {
+    pj_load_ini(ctx);
+    if (!ctx->crsToCrsCache.filename.empty()) {
+        return ctx->crsToCrsCache.filename;
+    }
+    const std::string path(proj_context_get_user_writable_directory(ctx, true));
+    ctx->crsToCrsCache.filename = path + "/crs_to_crs_cache.db";
+    return ctx->crsToCrsCache.filename;
+}
+
+// ---------------------------------------------------------------------------
+
+/** Return the result of proj_create_crs_to_crs() stored for cacheKey, or
+ * nullptr if there is none.
+ */
+PJ *pj_crs_to_crs_cache_get(PJ_CONTEXT *ctx, const std::string &cacheKey) {
+    auto cache = CrsToCrsCache::open(ctx);
+    if (!cache) {
+        return nullptr;
+    }
+    auto stmt = cache->prepare(
+        "SELECT r.is_single_operation, o.idx_in_original_list, o.pipeline, "
+        "o.name, o.accuracy, o.pseudo_area, o.area_name, o.minx_src, "
+        "o.miny_src, o.maxx_src, o.maxy_src, o.minx_dst, o.miny_dst, "
+        "o.maxx_dst, o.maxy_dst, o.src_is_lon_lat_degree, "
+        "o.src_is_lat_lon_degree, o.dst_is_lon_lat_degree, "
+        "o.dst_is_lat_lon_degree, o.src_geocentric_to_lon_lat, "
+        "o.dst_geocentric_to_lon_lat, o.coordinate_epoch "
+        "FROM crs_to_crs_result r JOIN crs_to_crs_operation o "
+        "ON o.result_id = r.id WHERE r.cache_key = ? ORDER BY o.idx");
+    if (!stmt) {
+        return nullptr;
+    }
+    stmt->bindText(cacheKey.c_str());
+
+    bool isSingleOperation = false;
+    std::vector<CachedOperation> cachedOps;
+    while (stmt->execute() == SQLITE_ROW) {
+        stmt->resetResIndex();
+        CachedOperation cachedOp;
+        isSingleOperation = stmt->getInt64() != 0;
+        cachedOp.idxInOriginalList = static_cast<int>(stmt->getInt64());
+        cachedOp.pipeline = stmt->getText();
+        cachedOp.name = stmt->getText();
+        cachedOp.accuracy = stmt->getDouble();
+        cachedOp.pseudoArea = stmt->getDouble();
+        cachedOp.areaName = stmt->getText();
+        for (double &v : cachedOp.bbox) {
+            v = stmt->getDouble();
+        }
+        cachedOp.srcIsLonLatDegree = stmt->getInt64() != 0;
+        cachedOp.srcIsLatLonDegree = stmt->getInt64() != 0;
+        cachedOp.dstIsLonLatDegree = stmt->getInt64() != 0;
+        cachedOp.dstIsLatLonDegree = stmt->getInt64() != 0;
+        const char *srcGeocentricToLonLat = stmt->getText();
+        if (srcGeocentricToLonLat) {
+            cachedOp.srcGeocentricToLonLat = srcGeocentricToLonLat;
+        }
+        const char *dstGeocentricToLonLat = stmt->getText();
+        if (dstGeocentricToLonLat) {
+            cachedOp.dstGeocentricToLonLat = dstGeocentricToLonLat;
+        }
+        cachedOp.hasCoordinateEpoch = !stmt->isNull();
+        cachedOp.coordinateEpoch = stmt->getDouble();
+        cachedOps.emplace_back(std::move(cachedOp));
+    }
+    stmt.reset();
+    cache.reset();
+    if (cachedOps.empty()) {
+        return nullptr;
+    }
+
+    const auto createOp = [ctx](const CachedOperation &cachedOp) {
+        auto op =
+            createCachedOperation(ctx, cachedOp.pipeline.c_str(),
+                                  cachedOp.name, cachedOp.accuracy);
+        if (op && cachedOp.hasCoordinateEpoch) {
+            op->hasCoordinateEpoch = true;
+            op->coordinateEpoch = cachedOp.coordinateEpoch;
+        }
+        return op;
+    };
+
+    if (isSingleOperation) {
+        return createOp(cachedOps.front());
+    }
+
+    std::vector<PJCoordOperation> preparedOpList;
+    for (const auto &cachedOp : cachedOps) {
+        PJ *op = createOp(cachedOp);
+        PJ *pjSrcGeocentricToLonLat =
+            cachedOp.srcGeocentricToLonLat.empty()
+                ? nullptr
+                : proj_create(ctx, cachedOp.srcGeocentricToLonLat.c_str());
+        PJ *pjDstGeocentricToLonLat =
+            cachedOp.dstGeocentricToLonLat.empty()
+                ? nullptr
+                : proj_create(ctx, cachedOp.dstGeocentricToLonLat.c_str());
+        if (!op ||
+            (!cachedOp.srcGeocentricToLonLat.empty() &&
+             !pjSrcGeocentricToLonLat) ||
+            (!cachedOp.dstGeocentricToLonLat.empty() &&
+             !pjDstGeocentricToLonLat)) {
+            proj_destroy(op);
+            proj_destroy(pjSrcGeocentricToLonLat);
+            proj_destroy(pjDstGeocentricToLonLat);
+            return nullptr;
+        }
+        const double *bbox = cachedOp.bbox;
+        preparedOpList.emplace_back(
+            cachedOp.idxInOriginalList, bbox[0], bbox[1], bbox[2], bbox[3],
+            bbox[4], bbox[5], bbox[6], bbox[7], op, cachedOp.name,
+            cachedOp.accuracy, cachedOp.pseudoArea, cachedOp.areaName.c_str(),
+            pjSrcGeocentricToLonLat, pjDstGeocentricToLonLat);
+        proj_destroy(pjSrcGeocentricToLonLat);
+        proj_destroy(pjDstGeocentricToLonLat);
+
+        // The operation has no source and target CRS: restore what was
+        // deduced from them.
+        auto &preparedOp = preparedOpList.back();
+        preparedOp.srcIsLonLatDegree = cachedOp.srcIsLonLatDegree;
+        preparedOp.srcIsLatLonDegree = cachedOp.srcIsLatLonDegree;
+        preparedOp.dstIsLonLatDegree = cachedOp.dstIsLonLatDegree;
+        preparedOp.dstIsLatLonDegree = cachedOp.dstIsLatLonDegree;
+    }
+
+    PJ *P = createCachedOperation(ctx, cachedOps.front().pipeline.c_str(),
+                                  std::string(), -1);
+    if (!P) {
+        return nullptr;
+    }
+    P->alternativeCoordinateOperations = std::move(preparedOpList);
+    // The returned P is rather dummy
+    P->descr = "Set of coordinate operations";
+    P->iso_obj = nullptr;
+    P->fwd = nullptr;
+    P->inv = nullptr;
+    P->fwd3d = nullptr;
+    P->inv3d = nullptr;
+    P->fwd4d = nullptr;
+    P->inv4d = nullptr;
+    return P;
+}
+
+// ---------------------------------------------------------------------------
+
+/** Store in the cache the result of proj_create_crs_to_crs() for cacheKey.
+ *
+ * Nothing is stored if one of the operations cannot be exported as a PROJ
+ * pipeline.
+ */
+void pj_crs_to_crs_cache_put(PJ_CONTEXT *ctx, const std::string &cacheKey,
+                             const PJ *P) {
+    std::vector<CachedOperation> cachedOps;
+    const bool isSingleOperation = P->alternativeCoordinateOperations.empty();
+    if (isSingleOperation) {
+        CachedOperation cachedOp;
+        if (!exportToCache(ctx, P, cachedOp.pipeline)) {
+            return;
+        }
+        const char *name = proj_get_name(P);
+        cachedOp.name = name ? name : "";
+        cachedOp.accuracy = proj_coordoperation_get_accuracy(ctx, P);
+        cachedOp.hasCoordinateEpoch = P->hasCoordinateEpoch;
+        cachedOp.coordinateEpoch = P->coordinateEpoch;
+        cachedOps.emplace_back(std::move(cachedOp));
+    } else {
+        for (const auto &alt : P->alternativeCoordinateOperations) {
+            CachedOperation cachedOp;
+            if (!exportToCache(ctx, alt.pj, cachedOp.pipeline) ||
+                (alt.pjSrcGeocentricToLonLat &&
+                 !exportToCache(ctx, alt.pjSrcGeocentricToLonLat,
+                                cachedOp.srcGeocentricToLonLat)) ||
+                (alt.pjDstGeocentricToLonLat &&
+                 !exportToCache(ctx, alt.pjDstGeocentricToLonLat,
+                                cachedOp.dstGeocentricToLonLat))) {
+                return;
+            }
+            cachedOp.idxInOriginalList = alt.idxInOriginalList;
+            cachedOp.name = alt.name;
+            cachedOp.accuracy = alt.accuracy;
+            cachedOp.pseudoArea = alt.pseudoArea;
+            cachedOp.areaName = alt.areaName;
+            const double bbox[] = {alt.minxSrc, alt.minySrc, alt.maxxSrc,
+                                   alt.maxySrc, alt.minxDst, alt.minyDst,
+                                   alt.maxxDst, alt.maxyDst};
+            std::copy(bbox, bbox + 8, cachedOp.bbox);
+            cachedOp.srcIsLonLatDegree = alt.srcIsLonLatDegree;
+            cachedOp.srcIsLatLonDegree = alt.srcIsLatLonDegree;
+            cachedOp.dstIsLonLatDegree = alt.dstIsLonLatDegree;
+            cachedOp.dstIsLatLonDegree = alt.dstIsLatLonDegree;
+            cachedOp.hasCoordinateEpoch = alt.pj->hasCoordinateEpoch;
+            cachedOp.coordinateEpoch = alt.pj->coordinateEpoch;
+            cachedOps.emplace_back(std::move(cachedOp));
+        }
+    }
+
+    auto cache = CrsToCrsCache::open(ctx);
+    if (!cache || !cache->exec("BEGIN IMMEDIATE")) {
+        return;
+    }
+
+    const auto rollback = [&cache]() { cache->exec("ROLLBACK"); };
+
+    auto stmt = cache->prepare(
+        "DELETE FROM crs_to_crs_operation WHERE result_id IN "
+        "(SELECT id FROM crs_to_crs_result WHERE cache_key = ?)");
+    if (!stmt) {
+        rollback();
+        return;
+    }
+    stmt->bindText(cacheKey.c_str());
+    if (stmt->execute() != SQLITE_DONE) {
+        rollback();
+        return;
+    }
+
+    stmt = cache->prepare("INSERT OR REPLACE INTO crs_to_crs_result"
+                          "(cache_key, is_single_operation) VALUES (?, ?)");
+    if (!stmt) {
+        rollback();
+        return;
+    }
+    stmt->bindText(cacheKey.c_str());
+    stmt->bindInt64(isSingleOperation ? 1 : 0);
+    if (stmt->execute() != SQLITE_DONE) {
+        rollback();
+        return;
+    }
+    const auto resultId = sqlite3_last_insert_rowid(cache->handle());
+
+    stmt = cache->prepare(
+        "INSERT INTO crs_to_crs_operation(result_id, idx, "
+        "idx_in_original_list, pipeline, name, accuracy, pseudo_area, "
+        "area_name, minx_src, miny_src, maxx_src, maxy_src, minx_dst, "
+        "miny_dst, maxx_dst, maxy_dst, src_is_lon_lat_degree, "
+        "src_is_lat_lon_degree, dst_is_lon_lat_degree, "
+        "dst_is_lat_lon_degree, src_geocentric_to_lon_lat, "
+        "dst_geocentric_to_lon_lat, coordinate_epoch) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, "
+        "?, ?, ?)");
+    if (!stmt) {
+        rollback();
+        return;
+    }
+    int idx = 0;
+    for (const auto &cachedOp : cachedOps) {
+        stmt->reset();
+        stmt->bindInt64(resultId);
+        stmt->bindInt64(idx);
+        ++idx;
+        stmt->bindInt64(cachedOp.idxInOriginalList);
+        stmt->bindText(cachedOp.pipeline.c_str());
+        stmt->bindText(cachedOp.name.c_str());
+        stmt->bindDouble(cachedOp.accuracy);
+        stmt->bindDouble(cachedOp.pseudoArea);
+        stmt->bindText(cachedOp.areaName.c_str());
+        for (double v : cachedOp.bbox) {
+            stmt->bindDouble(v);
+        }
+        stmt->bindInt64(cachedOp.srcIsLonLatDegree ? 1 : 0);
+        stmt->bindInt64(cachedOp.srcIsLatLonDegree ? 1 : 0);
+        stmt->bindInt64(cachedOp.dstIsLonLatDegree ? 1 : 0);
+        stmt->bindInt64(cachedOp.dstIsLatLonDegree ? 1 : 0);
+        if (cachedOp.srcGeocentricToLonLat.empty())
+            stmt->bindNull();
+        else
+            stmt->bindText(cachedOp.srcGeocentricToLonLat.c_str());
+        if (cachedOp.dstGeocentricToLonLat.empty())
+            stmt->bindNull();
+        else
+            stmt->bindText(cachedOp.dstGeocentricToLonLat.c_str());
+        if (cachedOp.hasCoordinateEpoch)
+            stmt->bindDouble(cachedOp.coordinateEpoch);
+        else
+            stmt->bindNull();
+        if (stmt->execute() != SQLITE_DONE) {
+            rollback();
+            return;
+        }
+    }
+
+    // Evict the oldest entries
+    stmt = cache->prepare("SELECT MAX(id) FROM crs_to_crs_result");
+    if (stmt && stmt->execute() == SQLITE_ROW) {
+        const auto minIdToKeep =
+            stmt->getInt64() - CRS_TO_CRS_CACHE_MAX_ENTRIES + 1;
+        if (minIdToKeep > 1) {
+            stmt = cache->prepare(
+                "DELETE FROM crs_to_crs_operation WHERE result_id < ?");
+            if (stmt) {
+                stmt->bindInt64(minIdToKeep);
+                stmt->execute();
+            }
+            stmt = cache->prepare(
+                "DELETE FROM crs_to_crs_result WHERE id < ?");
+            if (stmt) {
+                stmt->bindInt64(minIdToKeep);
+                stmt->execute();
+            }
+        }
+    }
+    stmt.reset();
+
+    cache->exec("COMMIT");
+}
+
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
+/** Enable or disable the persistent cache of proj_create_crs_to_crs()
+ * results.
+ *
+ * This overrides the setting in the PROJ configuration file.
+ *
+ * @param ctx PROJ context, or NULL
+ * @param enabled TRUE if the cache is enabled.
+ * @since 9.9
+ */
+void proj_crs_to_crs_cache_set_enable(PJ_CONTEXT *ctx, int enabled) {
+    if (ctx == nullptr) {
+        ctx = pj_get_default_ctx();
+    }
+    // Load ini file, now so as to override its settings
+    pj_load_ini(ctx);
+    ctx->crsToCrsCache.enabled = enabled != FALSE;
+}
+
+// ---------------------------------------------------------------------------
+
+/** Override, for the considered context, the path and file of the persistent
+ * cache of proj_create_crs_to_crs() results.
+ *
+ * @param ctx PROJ context, or NULL
+ * @param fullname Full name to the cache (encoded in UTF-8). If set to NULL,
+ *                 crs_to_crs_cache.db in the user writable directory is used.
+ * @since 9.9
+ */
+void proj_crs_to_crs_cache_set_filename(PJ_CONTEXT *ctx,
+                                        const char *fullname) {
+    if (ctx == nullptr) {
+        ctx = pj_get_default_ctx();
+    }
+    // Load ini file, now so as to override its settings
+    pj_load_ini(ctx);
+    ctx->crsToCrsCache.filename = fullname ? fullname : std::string();
+}
+
+// ---------------------------------------------------------------------------
+
+/** Clear the persistent cache of proj_create_crs_to_crs() results.
+ *
+ * This must be done after installing or removing grids, since the set of
+ * operations returned by proj_create_crs_to_crs() depends on them.
+ *
+ * @param ctx PROJ context, or NULL
+ * @since 9.9
+ */
+void proj_crs_to_crs_cache_clear(PJ_CONTEXT *ctx) {
+    if (ctx == nullptr) {
+        ctx = pj_get_default_ctx();
+    }
+    auto cache = CrsToCrsCache::open(ctx);
+    if (cache) {
+        cache->closeAndUnlink();
+    }
+}
@@ -174,8 +174,10 @@ pj_ctx::pj_ctx(const pj_ctx &other)
       iniFileLoaded(other.iniFileLoaded), endpoint(other.endpoint),
       networking(other.networking), ca_bundle_path(other.ca_bundle_path),
       native_ca(other.native_ca), gridChunkCache(other.gridChunkCache),
+      crsToCrsCache(other.crsToCrsCache),
       defaultTmercAlgo(other.defaultTmercAlgo),
       // END ini file settings
+      num_threads(other.num_threads),
       projStringParserCreateFromPROJStringRecursionCounter(0),
       pipelineInitRecursiongCounter(0) {
     set_search_paths(other.search_paths);
@@ -319,6 +321,17 @@ PJ_CONTEXT *proj_context_destroy(PJ_CONTEXT *ctx) {
     return nullptr;
 }
 
+/************************************************************************/
+/*                    proj_context_set_num_threads()                    */
+/************************************************************************/
+
+void proj_context_set_num_threads(PJ_CONTEXT *ctx, int num_threads) {
+    if (ctx == nullptr) {
+        ctx = pj_get_default_ctx();
+    }
+    ctx->num_threads = num_threads;
+}
+
 /************************************************************************/
 /*                  proj_context_use_proj4_init_rules()                 */
 /************************************************************************/
@@ -66,6 +66,8 @@
 #ifdef HAVE_LIBDL
 #include <dlfcn.h>
 #endif
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <unistd.h>
 #endif
@@ -903,18 +905,17 @@ std::unique_ptr<File> FileApiAdapter::open(PJ_CONTEXT *ctx,
 
 // ---------------------------------------------------------------------------
 
-#if EMBED_RESOURCE_FILES
-
 class FileMemory : public File {
     PJ_CONTEXT *m_ctx;
-    const unsigned char *const m_data;
-    const size_t m_size;
     size_t m_pos = 0;
 
     FileMemory(const FileMemory &) = delete;
     FileMemory &operator=(const FileMemory &) = delete;
 
   protected:
+    const unsigned char *const m_data;
+    const size_t m_size;
+
     FileMemory(const std::string &filename, PJ_CONTEXT *ctx,
                const unsigned char *data, size_t size)
         : File(filename), m_ctx(ctx), m_data(data), m_size(size) {}
@@ -928,6 +929,13 @@ class FileMemory : public File {
 
     bool hasChanged() const override { return false; }
 
+    const void *mappedRange(unsigned long long offset,
+                            size_t sizeBytes) const override {
+        if (offset > m_size || sizeBytes > m_size - offset)
+            return nullptr;
+        return m_data + offset;
+    }
+
     static std::unique_ptr<File> open(PJ_CONTEXT *ctx, const char *filename,
                                       FileAccess access,
                                       const unsigned char *data, size_t size) {
@@ -973,6 +981,82 @@ bool FileMemory::seek(unsigned long long offset, int whence) {
     }
 }
 
+// ---------------------------------------------------------------------------
+
+#if !(EMBED_RESOURCE_FILES && USE_ONLY_EMBEDDED_RESOURCE_FILES) &&             \
+    !defined(_WIN32)
+
+// Read-only local file whose content is memory-mapped, so that readers of
+// uncompressed grids can access it without copies, and that its pages are
+// shared with other processes through the OS page cache.
+class FileMmap : public FileMemory {
+    FileMmap(const FileMmap &) = delete;
+    FileMmap &operator=(const FileMmap &) = delete;
+
+  protected:
+    FileMmap(const std::string &filename, PJ_CONTEXT *ctx,
+             const unsigned char *data, size_t size)
+        : FileMemory(filename, ctx, data, size) {}
+
+  public:
+    ~FileMmap() override;
+
+    static std::unique_ptr<File> open(PJ_CONTEXT *ctx, const char *filename,
+                                      FileAccess access);
+
+    void prefetch(const std::vector<FileRange> &ranges) override;
+};
+
+// ---------------------------------------------------------------------------
+
+FileMmap::~FileMmap() {
+    munmap(const_cast<unsigned char *>(m_data), m_size);
+}
+
+// ---------------------------------------------------------------------------
+
+void FileMmap::prefetch(const std::vector<FileRange> &ranges) {
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (const auto &range : ranges) {
+        if (range.size == 0 || range.offset >= m_size)
+            continue;
+        const size_t start =
+            static_cast<size_t>(range.offset) & ~(pageSize - 1);
+        const size_t end = static_cast<size_t>(
+            std::min(range.offset + range.size,
+                     static_cast<unsigned long long>(m_size)));
+        posix_madvise(const_cast<unsigned char *>(m_data) + start, end - start,
+                      POSIX_MADV_WILLNEED);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<File> FileMmap::open(PJ_CONTEXT *ctx, const char *filename,
+                                     FileAccess access) {
+    if (access != FileAccess::READ_ONLY)
+        return nullptr;
+    const int fd = ::open(filename, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+    void *data = MAP_FAILED;
+    size_t size = 0;
+    struct stat sStat;
+    if (fstat(fd, &sStat) == 0 && S_ISREG(sStat.st_mode) &&
+        sStat.st_size > 0 &&
+        static_cast<unsigned long long>(sStat.st_size) <=
+            std::numeric_limits<size_t>::max()) {
+        size = static_cast<size_t>(sStat.st_size);
+        data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    // The mapping remains valid after the file descriptor is closed
+    close(fd);
+    if (data == MAP_FAILED)
+        return nullptr;
+    return std::unique_ptr<File>(new FileMmap(
+        filename, ctx, static_cast<const unsigned char *>(data), size));
+}
+
 #endif
 
 // ---------------------------------------------------------------------------
@@ -999,7 +1083,9 @@ std::unique_ptr<File> FileManager::open(PJ_CONTEXT *ctx, const char *filename,
 #ifdef _WIN32
     ret = FileWin32::open(ctx, filename, access);
 #else
-    ret = FileStdio::open(ctx, filename, access);
+    ret = FileMmap::open(ctx, filename, access);
+    if (!ret)
+        ret = FileStdio::open(ctx, filename, access);
 #endif
 #endif
 
@@ -2084,6 +2170,10 @@ void pj_load_ini(PJ_CONTEXT *ctx) {
                     val > 0 ? static_cast<long long>(val) * 1024 * 1024 : -1;
             } else if (key == "cache_ttl_sec") {
                 ctx->gridChunkCache.ttl = atoi(value.c_str());
+            } else if (key == "crs_to_crs_cache_enabled") {
+                ctx->crsToCrsCache.enabled = ci_equal(value, "ON") ||
+                                             ci_equal(value, "YES") ||
+                                             ci_equal(value, "TRUE");
             } else if (key == "tmerc_default_algo") {
                 if (value == "auto") {
                     ctx->defaultTmercAlgo = TMercAlgo::AUTO;
@@ -75,6 +75,13 @@ class FileManager {
 
 // ---------------------------------------------------------------------------
 
+struct FileRange {
+    unsigned long long offset;
+    size_t size;
+};
+
+// ---------------------------------------------------------------------------
+
 class File {
   protected:
     std::string name_;
@@ -93,6 +100,18 @@ class File {
     std::string PROJ_DLL read_line(size_t maxLen, bool &maxLenReached,
                                    bool &eofReached);
 
+    // Returns a pointer to the [offset, offset + sizeBytes[ range of the file
+    // content if it is directly accessible in memory (memory-mapped file),
+    // or nullptr.
+    virtual const void *mappedRange(unsigned long long /* offset */,
+                                    size_t /* sizeBytes */) const {
+        return nullptr;
+    }
+
+    // Hints that the given byte ranges will be read soon, so that they can
+    // be fetched in as few I/O requests as possible. Does nothing by default.
+    virtual void prefetch(const std::vector<FileRange> & /* ranges */) {}
+
     const std::string &name() const { return name_; }
 };
 
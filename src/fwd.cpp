@@ -309,3 +309,56 @@ bool pj_fwd4d(PJ_COORD &coo, PJ *P) {
     P->ctx->last_errno = last_errno;
     return true;
 }
+
+void pj_fwd4d_batch(PJ_COORD *coo, size_t n, int *errors, PJ *P) {
+
+    const int last_errno = P->ctx->last_errno;
+
+    /* No batched converter available: go point by point */
+    if (P->fwd4d_batch == nullptr ||
+        (P->fwd4d == nullptr && P->fwd3d == nullptr && P->fwd == nullptr)) {
+        for (size_t i = 0; i < n; i++) {
+            if (HUGE_VAL == coo[i].v[0])
+                continue;
+            P->ctx->last_errno = 0;
+            if (!pj_fwd4d(coo[i], P) && P->ctx->last_errno)
+                errors[i] = P->ctx->last_errno;
+        }
+        P->ctx->last_errno = last_errno;
+        return;
+    }
+
+    if (!P->skip_fwd_prepare) {
+        for (size_t i = 0; i < n; i++) {
+            if (HUGE_VAL == coo[i].v[0])
+                continue;
+            P->ctx->last_errno = 0;
+            fwd_prepare(P, coo[i]);
+            if (HUGE_VAL == coo[i].v[0] || P->ctx->last_errno) {
+                coo[i] = proj_coord_error();
+                if (P->ctx->last_errno)
+                    errors[i] = P->ctx->last_errno;
+            }
+        }
+    }
+
+    P->ctx->last_errno = 0;
+    P->fwd4d_batch(coo, n, errors, P);
+
+    for (size_t i = 0; i < n; i++) {
+        if (HUGE_VAL == coo[i].v[0]) {
+            coo[i] = proj_coord_error();
+            continue;
+        }
+        if (!P->skip_fwd_finalize) {
+            P->ctx->last_errno = 0;
+            fwd_finalize(P, coo[i]);
+            if (P->ctx->last_errno) {
+                errors[i] = P->ctx->last_errno;
+                coo[i] = proj_coord_error();
+            }
+        }
+    }
+
+    P->ctx->last_errno = last_errno;
+}
@@ -43,10 +43,16 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 NS_PROJ_START
 
@@ -129,6 +135,20 @@ VerticalShiftGrid::~VerticalShiftGrid() = default;
 
 // ---------------------------------------------------------------------------
 
+bool VerticalShiftGrid::valuesAt(int x_start, int y_start, int x_count,
+                                 int y_count, float *out) const {
+    for (int y = y_start; y < y_start + y_count; ++y) {
+        for (int x = x_start; x < x_start + x_count; ++x) {
+            if (!valueAt(x, y, *out))
+                return false;
+            ++out;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
 static ExtentAndRes globalExtent() {
     ExtentAndRes extent;
     extent.isGeographic = true;
@@ -170,41 +190,156 @@ bool NullVerticalShiftGrid::valueAt(int, int, float &out) const {
 
 // ---------------------------------------------------------------------------
 
-class FloatLineCache {
+// Process-wide cache of decoded grid blocks (TIFF tiles or strips, or lines
+// of GTX/NTv2 grids), shared by all contexts and threads, so that grids
+// opened several times (typically once per context) are decoded only once.
+// Blocks are immutable once inserted, and are handed out as shared pointers,
+// so that they remain valid for their users after being evicted.
+class GridBlockCache {
+  public:
+    typedef std::shared_ptr<const std::vector<unsigned char>> Block;
+
+    uint64_t getFileId(File *fp);
+
+    Block get(uint64_t fileId, uint32_t ifdIdx, uint32_t blockNumber);
+    void insert(uint64_t fileId, uint32_t ifdIdx, uint32_t blockNumber,
+                const Block &block);
+    void clear();
 
   private:
-    typedef uint64_t Key;
-    lru11::Cache<Key, std::vector<float>, lru11::NullLock> cache_;
+    struct Key {
+        uint64_t fileId;
+        uint64_t blockKey;
+
+        Key(uint64_t fileIdIn, uint32_t ifdIdx, uint32_t blockNumber)
+            : fileId(fileIdIn),
+              blockKey((static_cast<uint64_t>(ifdIdx) << 32) | blockNumber) {}
+        bool operator==(const Key &other) const {
+            return fileId == other.fileId && blockKey == other.blockKey;
+        }
+    };
 
-  public:
-    explicit FloatLineCache(size_t maxSize) : cache_(maxSize) {}
-    void insert(uint32_t subgridIdx, uint32_t lineNumber,
-                const std::vector<float> &data);
-    const std::vector<float> *get(uint32_t subgridIdx, uint32_t lineNumber);
+    struct KeyHasher {
+        std::size_t operator()(const Key &k) const {
+            return std::hash<uint64_t>{}(k.fileId * 0x9E3779B97F4A7C15ULL ^
+                                         k.blockKey);
+        }
+    };
+
+    // Each shard is a LRU list of blocks bounded by its size in bytes.
+    struct Shard {
+        std::mutex mutex{};
+        std::list<std::pair<Key, Block>> blocks{};
+        std::unordered_map<Key, std::list<std::pair<Key, Block>>::iterator,
+                           KeyHasher>
+            map{};
+        size_t sizeBytes = 0;
+    };
+
+    static constexpr size_t NUM_SHARDS = 16;
+    static constexpr size_t MAX_SIZE_BYTES = 128 * 1024 * 1024;
+
+    Shard shards_[NUM_SHARDS];
+
+    std::mutex fileIdsMutex_{};
+    std::map<std::string, uint64_t> fileIds_{};
+
+    Shard &shard(const Key &key) {
+        return shards_[KeyHasher{}(key) % NUM_SHARDS];
+    }
 };
 
 // ---------------------------------------------------------------------------
 
-void FloatLineCache::insert(uint32_t subgridIdx, uint32_t lineNumber,
-                            const std::vector<float> &data) {
-    cache_.insert((static_cast<uint64_t>(subgridIdx) << 32) | lineNumber, data);
+// Returns an identifier of the content of a file, which is the same for all
+// File objects opened on the same file, as long as it is not modified.
+uint64_t GridBlockCache::getFileId(File *fp) {
+    const auto oldPos = fp->tell();
+    fp->seek(0, SEEK_END);
+    const auto fileSize = fp->tell();
+    fp->seek(oldPos);
+    const std::string key(fp->name() + '\0' + std::to_string(fileSize));
+
+    std::lock_guard<std::mutex> lock(fileIdsMutex_);
+    const auto iter = fileIds_.find(key);
+    if (iter != fileIds_.end())
+        return iter->second;
+    const uint64_t fileId = fileIds_.size();
+    fileIds_[key] = fileId;
+    return fileId;
 }
 
 // ---------------------------------------------------------------------------
 
-const std::vector<float> *FloatLineCache::get(uint32_t subgridIdx,
-                                              uint32_t lineNumber) {
-    return cache_.getPtr((static_cast<uint64_t>(subgridIdx) << 32) |
-                         lineNumber);
+GridBlockCache::Block GridBlockCache::get(uint64_t fileId, uint32_t ifdIdx,
+                                          uint32_t blockNumber) {
+    const Key key(fileId, ifdIdx, blockNumber);
+    auto &s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    const auto iter = s.map.find(key);
+    if (iter == s.map.end())
+        return nullptr;
+    s.blocks.splice(s.blocks.begin(), s.blocks, iter->second);
+    return iter->second->second;
 }
 
 // ---------------------------------------------------------------------------
 
+void GridBlockCache::insert(uint64_t fileId, uint32_t ifdIdx,
+                            uint32_t blockNumber, const Block &block) {
+    const Key key(fileId, ifdIdx, blockNumber);
+    auto &s = shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    const auto iter = s.map.find(key);
+    if (iter != s.map.end()) {
+        // Another thread has decoded the same block concurrently
+        s.blocks.splice(s.blocks.begin(), s.blocks, iter->second);
+        return;
+    }
+    s.blocks.emplace_front(key, block);
+    s.map[key] = s.blocks.begin();
+    s.sizeBytes += block->size();
+
+    // Evict least recently used blocks, but always keep the new one
+    constexpr size_t MAX_SHARD_SIZE_BYTES = MAX_SIZE_BYTES / NUM_SHARDS;
+    while (s.sizeBytes > MAX_SHARD_SIZE_BYTES && s.blocks.size() > 1) {
+        const auto &last = s.blocks.back();
+        s.sizeBytes -= last.second->size();
+        s.map.erase(last.first);
+        s.blocks.pop_back();
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+void GridBlockCache::clear() {
+    for (auto &s : shards_) {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.map.clear();
+        s.blocks.clear();
+        s.sizeBytes = 0;
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+static GridBlockCache gGridBlockCache{};
+
+// ---------------------------------------------------------------------------
+
+void pj_clear_grid_block_cache() { gGridBlockCache.clear(); }
+
+// ---------------------------------------------------------------------------
+
 class GTXVerticalShiftGrid : public VerticalShiftGrid {
     PJ_CONTEXT *m_ctx;
     std::unique_ptr<File> m_fp;
-    std::unique_ptr<FloatLineCache> m_cache;
-    mutable std::vector<float> m_buffer{};
+    uint64_t m_fileId;
+    const unsigned char *m_mappedData; // set if m_fp is memory-mapped
+    mutable GridBlockCache::Block m_line{};
+    mutable int m_lineIdx = -1;
+
+    const float *lineAt(int y) const;
 
     GTXVerticalShiftGrid(const GTXVerticalShiftGrid &) = delete;
     GTXVerticalShiftGrid &operator=(const GTXVerticalShiftGrid &) = delete;
@@ -212,14 +347,19 @@ class GTXVerticalShiftGrid : public VerticalShiftGrid {
   public:
     explicit GTXVerticalShiftGrid(PJ_CONTEXT *ctx, std::unique_ptr<File> &&fp,
                                   const std::string &nameIn, int widthIn,
-                                  int heightIn, const ExtentAndRes &extentIn,
-                                  std::unique_ptr<FloatLineCache> &&cache)
+                                  int heightIn, const ExtentAndRes &extentIn)
         : VerticalShiftGrid(nameIn, widthIn, heightIn, extentIn), m_ctx(ctx),
-          m_fp(std::move(fp)), m_cache(std::move(cache)) {}
+          m_fp(std::move(fp)),
+          m_fileId(gGridBlockCache.getFileId(m_fp.get())),
+          m_mappedData(static_cast<const unsigned char *>(m_fp->mappedRange(
+              40, sizeof(float) * widthIn * static_cast<size_t>(heightIn)))) {
+    }
 
     ~GTXVerticalShiftGrid() override;
 
     bool valueAt(int x, int y, float &out) const override;
+    bool valuesAt(int x_start, int y_start, int x_count, int y_count,
+                  float *out) const override;
     bool isNodata(float val, double multiplier) const override;
 
     const std::string &metadataItem(const std::string &, int) const override {
@@ -307,50 +447,100 @@ GTXVerticalShiftGrid *GTXVerticalShiftGrid::open(PJ_CONTEXT *ctx,
     extent.north = (yorigin + ystep * (rows - 1)) * DEG_TO_RAD;
     extent.computeInvRes();
 
-    // Cache up to 1 megapixel per GTX file
-    const int maxLinesInCache = 1024 * 1024 / columns;
-    auto cache = std::make_unique<FloatLineCache>(maxLinesInCache);
     return new GTXVerticalShiftGrid(ctx, std::move(fp), name, columns, rows,
-                                    extent, std::move(cache));
+                                    extent);
 }
 
 // ---------------------------------------------------------------------------
 
-bool GTXVerticalShiftGrid::valueAt(int x, int y, float &out) const {
-    assert(x >= 0 && y >= 0 && x < m_width && y < m_height);
+const float *GTXVerticalShiftGrid::lineAt(int y) const {
+    if (y != m_lineIdx) {
+        auto line = gGridBlockCache.get(m_fileId, 0, y);
+        if (line == nullptr) {
+            const size_t nLineSizeInBytes = sizeof(float) * m_width;
+            std::shared_ptr<std::vector<unsigned char>> buffer;
+            try {
+                buffer = std::make_shared<std::vector<unsigned char>>(
+                    nLineSizeInBytes);
+            } catch (const std::exception &e) {
+                pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
+                return nullptr;
+            }
 
-    const std::vector<float> *pBuffer = m_cache->get(0, y);
-    if (pBuffer == nullptr) {
-        try {
-            m_buffer.resize(m_width);
-        } catch (const std::exception &e) {
-            pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
-            return false;
-        }
+            m_fp->seek(40 +
+                       nLineSizeInBytes * static_cast<unsigned long long>(y));
+            if (m_fp->read(buffer->data(), nLineSizeInBytes) !=
+                nLineSizeInBytes) {
+                proj_context_errno_set(
+                    m_ctx, PROJ_ERR_INVALID_OP_FILE_NOT_FOUND_OR_INVALID);
+                return nullptr;
+            }
 
-        const size_t nLineSizeInBytes = sizeof(float) * m_width;
-        m_fp->seek(40 + nLineSizeInBytes * static_cast<unsigned long long>(y));
-        if (m_fp->read(&m_buffer[0], nLineSizeInBytes) != nLineSizeInBytes) {
-            proj_context_errno_set(
-                m_ctx, PROJ_ERR_INVALID_OP_FILE_NOT_FOUND_OR_INVALID);
-            return false;
+            if (IS_LSB) {
+                swap_words(buffer->data(), sizeof(float), m_width);
+            }
+
+            line = std::move(buffer);
+            try {
+                gGridBlockCache.insert(m_fileId, 0, y, line);
+            } catch (const std::exception &e) {
+                // Should normally not happen
+                pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
+            }
         }
+        m_line = std::move(line);
+        m_lineIdx = y;
+    }
+
+    return reinterpret_cast<const float *>(m_line->data());
+}
 
+// ---------------------------------------------------------------------------
+
+bool GTXVerticalShiftGrid::valueAt(int x, int y, float &out) const {
+    assert(x >= 0 && y >= 0 && x < m_width && y < m_height);
+
+    if (m_mappedData) {
+        memcpy(&out,
+               m_mappedData +
+                   sizeof(float) * (static_cast<size_t>(y) * m_width + x),
+               sizeof(float));
         if (IS_LSB) {
-            swap_words(&m_buffer[0], sizeof(float), m_width);
+            swap_words(&out, sizeof(float), 1);
         }
+        return true;
+    }
 
-        out = m_buffer[x];
-        try {
-            m_cache->insert(0, y, m_buffer);
-        } catch (const std::exception &e) {
-            // Should normally not happen
-            pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
+    const float *line = lineAt(y);
+    if (line == nullptr)
+        return false;
+    out = line[x];
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
+bool GTXVerticalShiftGrid::valuesAt(int x_start, int y_start, int x_count,
+                                    int y_count, float *out) const {
+    assert(x_start >= 0 && y_start >= 0 && x_count >= 0 && y_count >= 0 &&
+           x_start + x_count <= m_width && y_start + y_count <= m_height);
+
+    for (int y = y_start; y < y_start + y_count; ++y) {
+        if (m_mappedData) {
+            const size_t offset = static_cast<size_t>(y) * m_width + x_start;
+            memcpy(out, m_mappedData + sizeof(float) * offset,
+                   sizeof(float) * x_count);
+            if (IS_LSB) {
+                swap_words(out, sizeof(float), x_count);
+            }
+        } else {
+            const float *line = lineAt(y);
+            if (line == nullptr)
+                return false;
+            memcpy(out, line + x_start, sizeof(float) * x_count);
         }
-    } else {
-        out = (*pBuffer)[x];
+        out += x_count;
     }
-
     return true;
 }
 
@@ -407,43 +597,11 @@ constexpr uint16_t TIFFTAG_GDAL_NODATA = 42113;
 
 // ---------------------------------------------------------------------------
 
-class BlockCache {
-  public:
-    void insert(uint32_t ifdIdx, uint32_t blockNumber,
-                const std::vector<unsigned char> &data);
-    const std::vector<unsigned char> *get(uint32_t ifdIdx,
-                                          uint32_t blockNumber);
-
-  private:
-    typedef uint64_t Key;
-
-    static constexpr int NUM_BLOCKS_AT_CROSSING_TILES = 4;
-    static constexpr int MAX_SAMPLE_COUNT = 3;
-    lru11::Cache<Key, std::vector<unsigned char>, lru11::NullLock> cache_{
-        NUM_BLOCKS_AT_CROSSING_TILES * MAX_SAMPLE_COUNT};
-};
-
-// ---------------------------------------------------------------------------
-
-void BlockCache::insert(uint32_t ifdIdx, uint32_t blockNumber,
-                        const std::vector<unsigned char> &data) {
-    cache_.insert((static_cast<uint64_t>(ifdIdx) << 32) | blockNumber, data);
-}
-
-// ---------------------------------------------------------------------------
-
-const std::vector<unsigned char> *BlockCache::get(uint32_t ifdIdx,
-                                                  uint32_t blockNumber) {
-    return cache_.getPtr((static_cast<uint64_t>(ifdIdx) << 32) | blockNumber);
-}
-
-// ---------------------------------------------------------------------------
-
 class GTiffGrid : public Grid {
-    PJ_CONTEXT *m_ctx;   // owned by the belonging GTiffDataset
-    TIFF *m_hTIFF;       // owned by the belonging GTiffDataset
-    BlockCache &m_cache; // owned by the belonging GTiffDataset
-    File *m_fp;          // owned by the belonging GTiffDataset
+    PJ_CONTEXT *m_ctx; // owned by the belonging GTiffDataset
+    TIFF *m_hTIFF;     // owned by the belonging GTiffDataset
+    File *m_fp;        // owned by the belonging GTiffDataset
+    uint64_t m_fileId;
     uint32_t m_ifdIdx;
     TIFFDataType m_dt;
     uint16_t m_samplesPerPixel;
@@ -453,8 +611,13 @@ class GTiffGrid : public Grid {
     bool m_tiled;
     uint32_t m_blockWidth = 0;
     uint32_t m_blockHeight = 0;
-    mutable std::vector<unsigned char> m_buffer{};
-    mutable uint32_t m_bufferBlockId = std::numeric_limits<uint32_t>::max();
+    size_t m_blockSize = 0;
+    // Pointers to the blocks in the memory-mapped file, when they can be
+    // used without decoding (uncompressed data in native byte order).
+    std::vector<const unsigned char *> m_mappedBlocks{};
+    mutable GridBlockCache::Block m_block{};
+    mutable const unsigned char *m_blockData = nullptr;
+    mutable uint32_t m_blockId = std::numeric_limits<uint32_t>::max();
     unsigned m_blocksPerRow = 0;
     unsigned m_blocksPerCol = 0;
     unsigned m_blocks = 0;
@@ -470,12 +633,14 @@ class GTiffGrid : public Grid {
     GTiffGrid(const GTiffGrid &) = delete;
     GTiffGrid &operator=(const GTiffGrid &) = delete;
 
+    const unsigned char *getBlock(uint32_t blockId) const;
+
     template <class T>
-    float readValue(const std::vector<unsigned char> &buffer,
-                    uint32_t offsetInBlock, uint16_t sample) const;
+    float readValue(const unsigned char *buffer, uint32_t offsetInBlock,
+                    uint16_t sample) const;
 
   public:
-    GTiffGrid(PJ_CONTEXT *ctx, TIFF *hTIFF, BlockCache &cache, File *fp,
+    GTiffGrid(PJ_CONTEXT *ctx, TIFF *hTIFF, File *fp, uint64_t fileId,
               uint32_t ifdIdx, const std::string &nameIn, int widthIn,
               int heightIn, const ExtentAndRes &extentIn, TIFFDataType dtIn,
               uint16_t samplesPerPixelIn, uint16_t planarConfig,
@@ -501,17 +666,19 @@ class GTiffGrid : public Grid {
     void reassign_context(PJ_CONTEXT *ctx) { m_ctx = ctx; }
 
     bool hasChanged() const override { return m_fp->hasChanged(); }
+
+    void prefetch(const ExtentAndRes &area) const;
 };
 
 // ---------------------------------------------------------------------------
 
-GTiffGrid::GTiffGrid(PJ_CONTEXT *ctx, TIFF *hTIFF, BlockCache &cache, File *fp,
+GTiffGrid::GTiffGrid(PJ_CONTEXT *ctx, TIFF *hTIFF, File *fp, uint64_t fileId,
                      uint32_t ifdIdx, const std::string &nameIn, int widthIn,
                      int heightIn, const ExtentAndRes &extentIn,
                      TIFFDataType dtIn, uint16_t samplesPerPixelIn,
                      uint16_t planarConfig, bool bottomUpIn)
     : Grid(nameIn, widthIn, heightIn, extentIn), m_ctx(ctx), m_hTIFF(hTIFF),
-      m_cache(cache), m_fp(fp), m_ifdIdx(ifdIdx), m_dt(dtIn),
+      m_fp(fp), m_fileId(fileId), m_ifdIdx(ifdIdx), m_dt(dtIn),
       m_samplesPerPixel(samplesPerPixelIn),
       m_planarConfig(samplesPerPixelIn == 1 ? static_cast<uint16_t>(-1)
                                             : planarConfig),
@@ -537,6 +704,54 @@ GTiffGrid::GTiffGrid(PJ_CONTEXT *ctx, TIFF *hTIFF, BlockCache &cache, File *fp,
     m_blocksPerRow = (m_width + m_blockWidth - 1) / m_blockWidth;
     m_blocksPerCol = (m_height + m_blockHeight - 1) / m_blockHeight;
     m_blocks = m_blocksPerRow * m_blocksPerCol;
+    m_blockSize = static_cast<size_t>(m_tiled ? TIFFTileSize64(m_hTIFF)
+                                              : TIFFStripSize64(m_hTIFF));
+
+    uint16_t compression = COMPRESSION_NONE;
+    if (!TIFFGetField(m_hTIFF, TIFFTAG_COMPRESSION, &compression))
+        compression = COMPRESSION_NONE;
+    if (compression == COMPRESSION_NONE && !TIFFIsByteSwapped(m_hTIFF) &&
+        m_fp->mappedRange(0, 1) != nullptr) {
+        size_t dtSize = 0;
+        switch (m_dt) {
+        case TIFFDataType::Int16:
+        case TIFFDataType::UInt16:
+            dtSize = 2;
+            break;
+        case TIFFDataType::Int32:
+        case TIFFDataType::UInt32:
+        case TIFFDataType::Float32:
+            dtSize = 4;
+            break;
+        case TIFFDataType::Float64:
+            dtSize = 8;
+            break;
+        }
+        const unsigned nBlocks = m_planarConfig == PLANARCONFIG_SEPARATE
+                                     ? m_blocks * m_samplesPerPixel
+                                     : m_blocks;
+        toff_t *offsets = nullptr;
+        toff_t *byteCounts = nullptr;
+        if (TIFFGetField(m_hTIFF,
+                         m_tiled ? TIFFTAG_TILEOFFSETS : TIFFTAG_STRIPOFFSETS,
+                         &offsets) &&
+            TIFFGetField(m_hTIFF,
+                         m_tiled ? TIFFTAG_TILEBYTECOUNTS
+                                 : TIFFTAG_STRIPBYTECOUNTS,
+                         &byteCounts) &&
+            offsets && byteCounts) {
+            m_mappedBlocks.resize(nBlocks);
+            for (unsigned i = 0; i < nBlocks; ++i) {
+                // Short last strips must go through libtiff
+                if (byteCounts[i] < m_blockSize)
+                    continue;
+                const auto ptr = static_cast<const unsigned char *>(
+                    m_fp->mappedRange(offsets[i], m_blockSize));
+                if (ptr && reinterpret_cast<uintptr_t>(ptr) % dtSize == 0)
+                    m_mappedBlocks[i] = ptr;
+            }
+        }
+    }
 
     const char *text = nullptr;
     // Poor-man XML parsing of TIFFTAG_GDAL_METADATA tag. Hopefully good
@@ -638,11 +853,154 @@ GTiffGrid::~GTiffGrid() = default;
 
 // ---------------------------------------------------------------------------
 
+const unsigned char *GTiffGrid::getBlock(uint32_t blockId) const {
+    if (blockId == m_blockId)
+        return m_blockData;
+
+    if (blockId < m_mappedBlocks.size() && m_mappedBlocks[blockId]) {
+        m_block.reset();
+        m_blockData = m_mappedBlocks[blockId];
+        m_blockId = blockId;
+        return m_blockData;
+    }
+
+    auto block = gGridBlockCache.get(m_fileId, m_ifdIdx, blockId);
+    if (block == nullptr) {
+        if (TIFFCurrentDirOffset(m_hTIFF) != m_dirOffset &&
+            !TIFFSetSubDirectory(m_hTIFF, m_dirOffset)) {
+            return nullptr;
+        }
+
+        std::shared_ptr<std::vector<unsigned char>> buffer;
+        try {
+            buffer = std::make_shared<std::vector<unsigned char>>(m_blockSize);
+        } catch (const std::exception &e) {
+            pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
+            return nullptr;
+        }
+
+        if (m_tiled) {
+            if (TIFFReadEncodedTile(m_hTIFF, blockId, buffer->data(),
+                                    buffer->size()) == -1) {
+                return nullptr;
+            }
+        } else {
+            if (TIFFReadEncodedStrip(m_hTIFF, blockId, buffer->data(),
+                                     buffer->size()) == -1) {
+                return nullptr;
+            }
+        }
+
+        block = std::move(buffer);
+        try {
+            gGridBlockCache.insert(m_fileId, m_ifdIdx, blockId, block);
+        } catch (const std::exception &e) {
+            // Should normally not happen
+            pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
+        }
+    }
+
+    m_block = std::move(block);
+    m_blockData = m_block->data();
+    m_blockId = blockId;
+    return m_blockData;
+}
+
+// ---------------------------------------------------------------------------
+
+// Load in the block cache the blocks needed to interpolate in the
+// intersection of the grid with area (a geographic extent in radians).
+void GTiffGrid::prefetch(const ExtentAndRes &area) const {
+    if (!m_extent.isGeographic)
+        return;
+
+    double west = area.west;
+    double east = area.east;
+    if (!m_extent.fullWorldLongitude()) {
+        if (west > m_extent.east) {
+            west -= 2 * M_PI;
+            east -= 2 * M_PI;
+        } else if (east < m_extent.west) {
+            west += 2 * M_PI;
+            east += 2 * M_PI;
+        }
+    }
+    const double x0 = (west - m_extent.west) * m_extent.invResX;
+    const double x1 = (east - m_extent.west) * m_extent.invResX;
+    const double y0 = (area.south - m_extent.south) * m_extent.invResY;
+    const double y1 = (area.north - m_extent.south) * m_extent.invResY;
+    if (!(x1 >= -1 && x0 <= m_width && y1 >= -1 && y0 <= m_height))
+        return;
+
+    // Bilinear interpolation also needs the pixels next to the extent
+    const auto clamp = [](double v, int maxVal) {
+        return static_cast<int>(
+            std::max(0.0, std::min(v, static_cast<double>(maxVal))));
+    };
+    const int xMin = clamp(std::floor(x0), m_width - 1);
+    const int xMax = clamp(std::floor(x1) + 1, m_width - 1);
+    const int yMin = clamp(std::floor(y0), m_height - 1);
+    const int yMax = clamp(std::floor(y1) + 1, m_height - 1);
+    const int rowMin = m_bottomUp ? yMin : m_height - 1 - yMax;
+    const int rowMax = m_bottomUp ? yMax : m_height - 1 - yMin;
+
+    const unsigned nPlanes =
+        m_planarConfig == PLANARCONFIG_SEPARATE ? m_samplesPerPixel : 1;
+    std::vector<uint32_t> blockIds;
+    for (unsigned plane = 0; plane < nPlanes; ++plane) {
+        for (unsigned blockY = rowMin / m_blockHeight;
+             blockY <= rowMax / m_blockHeight; ++blockY) {
+            for (unsigned blockX = xMin / m_blockWidth;
+                 blockX <= xMax / m_blockWidth; ++blockX) {
+                blockIds.push_back(plane * m_blocks +
+                                   blockY * m_blocksPerRow + blockX);
+            }
+        }
+    }
+
+    if (TIFFCurrentDirOffset(m_hTIFF) != m_dirOffset &&
+        !TIFFSetSubDirectory(m_hTIFF, m_dirOffset)) {
+        return;
+    }
+
+    // Let the file fetch all the needed byte ranges at once, instead of
+    // block after block when decoding them below.
+    toff_t *offsets = nullptr;
+    toff_t *byteCounts = nullptr;
+    if (TIFFGetField(m_hTIFF,
+                     m_tiled ? TIFFTAG_TILEOFFSETS : TIFFTAG_STRIPOFFSETS,
+                     &offsets) &&
+        TIFFGetField(m_hTIFF,
+                     m_tiled ? TIFFTAG_TILEBYTECOUNTS
+                             : TIFFTAG_STRIPBYTECOUNTS,
+                     &byteCounts) &&
+        offsets && byteCounts) {
+        std::vector<FileRange> ranges;
+        for (const auto blockId : blockIds) {
+            if (byteCounts[blockId] > 0) {
+                ranges.push_back(
+                    FileRange{offsets[blockId],
+                              static_cast<size_t>(byteCounts[blockId])});
+            }
+        }
+        m_fp->prefetch(ranges);
+    }
+
+    for (const auto blockId : blockIds) {
+        if (blockId < m_mappedBlocks.size() && m_mappedBlocks[blockId])
+            continue;
+        if (gGridBlockCache.get(m_fileId, m_ifdIdx, blockId) == nullptr)
+            getBlock(blockId);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 template <class T>
-float GTiffGrid::readValue(const std::vector<unsigned char> &buffer,
+float GTiffGrid::readValue(const unsigned char *buffer,
                            uint32_t offsetInBlock, uint16_t sample) const {
-    const auto ptr = reinterpret_cast<const T *>(buffer.data());
-    assert(offsetInBlock < buffer.size() / sizeof(T));
+    const auto ptr = reinterpret_cast<const T *>(buffer);
+    assert(offsetInBlock < m_blockSize / sizeof(T));
     const auto val = ptr[offsetInBlock];
     if ((!m_hasNodata || static_cast<float>(val) != m_noData) &&
         sample < m_adfScale.size()) {
@@ -694,45 +1052,9 @@ bool GTiffGrid::valueAt(uint16_t sample, int x, int yFromBottom,
         blockId += sample * m_blocks;
     }
 
-    const std::vector<unsigned char> *pBuffer =
-        blockId == m_bufferBlockId ? &m_buffer : m_cache.get(m_ifdIdx, blockId);
-    if (pBuffer == nullptr) {
-        if (TIFFCurrentDirOffset(m_hTIFF) != m_dirOffset &&
-            !TIFFSetSubDirectory(m_hTIFF, m_dirOffset)) {
-            return false;
-        }
-        if (m_buffer.empty()) {
-            const auto blockSize = static_cast<size_t>(
-                m_tiled ? TIFFTileSize64(m_hTIFF) : TIFFStripSize64(m_hTIFF));
-            try {
-                m_buffer.resize(blockSize);
-            } catch (const std::exception &e) {
-                pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
-                return false;
-            }
-        }
-
-        if (m_tiled) {
-            if (TIFFReadEncodedTile(m_hTIFF, blockId, m_buffer.data(),
-                                    m_buffer.size()) == -1) {
-                return false;
-            }
-        } else {
-            if (TIFFReadEncodedStrip(m_hTIFF, blockId, m_buffer.data(),
-                                     m_buffer.size()) == -1) {
-                return false;
-            }
-        }
-
-        pBuffer = &m_buffer;
-        try {
-            m_cache.insert(m_ifdIdx, blockId, m_buffer);
-            m_bufferBlockId = blockId;
-        } catch (const std::exception &e) {
-            // Should normally not happen
-            pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
-        }
-    }
+    const unsigned char *pBuffer = getBlock(blockId);
+    if (pBuffer == nullptr)
+        return false;
 
     uint32_t offsetInBlock;
     if (m_blockIs256Pixel)
@@ -744,27 +1066,27 @@ bool GTiffGrid::valueAt(uint16_t sample, int x, int yFromBottom,
 
     switch (m_dt) {
     case TIFFDataType::Int16:
-        out = readValue<short>(*pBuffer, offsetInBlock, sample);
+        out = readValue<short>(pBuffer, offsetInBlock, sample);
         break;
 
     case TIFFDataType::UInt16:
-        out = readValue<unsigned short>(*pBuffer, offsetInBlock, sample);
+        out = readValue<unsigned short>(pBuffer, offsetInBlock, sample);
         break;
 
     case TIFFDataType::Int32:
-        out = readValue<int>(*pBuffer, offsetInBlock, sample);
+        out = readValue<int>(pBuffer, offsetInBlock, sample);
         break;
 
     case TIFFDataType::UInt32:
-        out = readValue<unsigned int>(*pBuffer, offsetInBlock, sample);
+        out = readValue<unsigned int>(pBuffer, offsetInBlock, sample);
         break;
 
     case TIFFDataType::Float32:
-        out = readValue<float>(*pBuffer, offsetInBlock, sample);
+        out = readValue<float>(pBuffer, offsetInBlock, sample);
         break;
 
     case TIFFDataType::Float64:
-        out = readValue<double>(*pBuffer, offsetInBlock, sample);
+        out = readValue<double>(pBuffer, offsetInBlock, sample);
         break;
     }
 
@@ -799,47 +1121,9 @@ bool GTiffGrid::valuesAt(int x_start, int y_start, int x_count, int y_count,
         blockYOff = yTIFF % 256;
         blockId = blockY * m_blocksPerRow + blockX;
 
-        const std::vector<unsigned char> *pBuffer =
-            blockId == m_bufferBlockId ? &m_buffer
-                                       : m_cache.get(m_ifdIdx, blockId);
-        if (pBuffer == nullptr) {
-            if (TIFFCurrentDirOffset(m_hTIFF) != m_dirOffset &&
-                !TIFFSetSubDirectory(m_hTIFF, m_dirOffset)) {
-                return false;
-            }
-            if (m_buffer.empty()) {
-                const auto blockSize =
-                    static_cast<size_t>(m_tiled ? TIFFTileSize64(m_hTIFF)
-                                                : TIFFStripSize64(m_hTIFF));
-                try {
-                    m_buffer.resize(blockSize);
-                } catch (const std::exception &e) {
-                    pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
-                    return false;
-                }
-            }
-
-            if (m_tiled) {
-                if (TIFFReadEncodedTile(m_hTIFF, blockId, m_buffer.data(),
-                                        m_buffer.size()) == -1) {
-                    return false;
-                }
-            } else {
-                if (TIFFReadEncodedStrip(m_hTIFF, blockId, m_buffer.data(),
-                                         m_buffer.size()) == -1) {
-                    return false;
-                }
-            }
-
-            pBuffer = &m_buffer;
-            try {
-                m_cache.insert(m_ifdIdx, blockId, m_buffer);
-                m_bufferBlockId = blockId;
-            } catch (const std::exception &e) {
-                // Should normally not happen
-                pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
-            }
-        }
+        const unsigned char *pBuffer = getBlock(blockId);
+        if (pBuffer == nullptr)
+            return false;
 
         uint32_t offsetInBlockStart = blockXOff + blockYOff * 256U;
 
@@ -852,7 +1136,7 @@ bool GTiffGrid::valuesAt(int x_start, int y_start, int x_count, int y_count,
                         m_samplesPerPixel +
                     sample_idx[0];
                 memcpy(out,
-                       reinterpret_cast<const float *>(pBuffer->data()) +
+                       reinterpret_cast<const float *>(pBuffer) +
                            offsetInBlock,
                        sample_count_mul_x_count * sizeof(float));
                 out += sample_count_mul_x_count;
@@ -867,7 +1151,7 @@ bool GTiffGrid::valuesAt(int x_start, int y_start, int x_count, int y_count,
                             m_samplesPerPixel +
                         sample_idx[0];
                     const float *in_ptr =
-                        reinterpret_cast<const float *>(pBuffer->data()) +
+                        reinterpret_cast<const float *>(pBuffer) +
                         offsetInBlock;
                     for (int x = 0; x < x_count; ++x) {
                         memcpy(out, in_ptr, sample_count * sizeof(float));
@@ -884,7 +1168,7 @@ bool GTiffGrid::valuesAt(int x_start, int y_start, int x_count, int y_count,
                             m_samplesPerPixel +
                         sample_idx[0];
                     const float *in_ptr =
-                        reinterpret_cast<const float *>(pBuffer->data()) +
+                        reinterpret_cast<const float *>(pBuffer) +
                         offsetInBlock;
                     for (int x = 0; x < x_count; ++x) {
                         memcpy(out, in_ptr, sample_count * sizeof(float));
@@ -901,7 +1185,7 @@ bool GTiffGrid::valuesAt(int x_start, int y_start, int x_count, int y_count,
                             m_samplesPerPixel +
                         sample_idx[0];
                     const float *in_ptr =
-                        reinterpret_cast<const float *>(pBuffer->data()) +
+                        reinterpret_cast<const float *>(pBuffer) +
                         offsetInBlock;
                     for (int x = 0; x < x_count; ++x) {
                         memcpy(out, in_ptr, sample_count * sizeof(float));
@@ -958,7 +1242,7 @@ class GTiffDataset {
     uint32_t m_ifdIdx = 0;
     toff_t m_nextDirOffset = 0;
     std::string m_filename{};
-    BlockCache m_cache{};
+    uint64_t m_fileId = 0;
 
     GTiffDataset(const GTiffDataset &) = delete;
     GTiffDataset &operator=(const GTiffDataset &) = delete;
@@ -1082,6 +1366,7 @@ bool GTiffDataset::openTIFF(const std::string &filename) {
                        GTiffDataset::tiffUnmapProc);
 
     m_filename = filename;
+    m_fileId = gGridBlockCache.getFileId(m_fp.get());
     m_hasNextGrid = true;
     return m_hTIFF != nullptr;
 }
@@ -1318,7 +1603,7 @@ std::unique_ptr<GTiffGrid> GTiffDataset::nextGrid() {
     }
 
     auto ret = std::unique_ptr<GTiffGrid>(new GTiffGrid(
-        m_ctx, m_hTIFF, m_cache, m_fp.get(), m_ifdIdx, m_filename, width,
+        m_ctx, m_hTIFF, m_fp.get(), m_fileId, m_ifdIdx, m_filename, width,
         height, extent, dt, samplesPerPixel, planarConfig, vRes < 0));
     m_ifdIdx++;
     m_hasNextGrid = TIFFReadDirectory(m_hTIFF) != 0;
@@ -1461,6 +1746,14 @@ class GTiffVGrid : public VerticalShiftGrid {
         return m_grid->valueAt(m_idxSample, x, y, out);
     }
 
+    bool valuesAt(int x_start, int y_start, int x_count, int y_count,
+                  float *out) const override {
+        const int idxSample = m_idxSample;
+        bool nodataFound = false;
+        return m_grid->valuesAt(x_start, y_start, x_count, y_count, 1,
+                                &idxSample, out, nodataFound);
+    }
+
     bool isNodata(float val, double /* multiplier */) const override {
         return m_grid->isNodata(val);
     }
@@ -1677,7 +1970,9 @@ VerticalShiftGridSet::open(PJ_CONTEXT *ctx, const std::string &filename) {
 bool VerticalShiftGridSet::reopen(PJ_CONTEXT *ctx) {
     pj_log(ctx, PJ_LOG_DEBUG, "Grid %s has changed. Re-loading it",
            m_name.c_str());
+    gGridBlockCache.clear();
     auto newGS = open(ctx, m_name);
+    m_lastGridAt = GridAtCache();
     m_grids.clear();
     if (newGS) {
         m_grids = std::move(newGS->m_grids);
@@ -1706,6 +2001,183 @@ static bool isPointInExtent(double x, double y, const ExtentAndRes &extent,
 
 // ---------------------------------------------------------------------------
 
+namespace {
+struct GridAtBox {
+    double west;
+    double south;
+    double east;
+    double north;
+};
+} // namespace
+
+// Stand-in for an unbounded longitude range in a GridAtBox
+constexpr double GRID_AT_BOX_UNBOUNDED = 1e300;
+
+static bool isBoxEmpty(const GridAtBox &box) {
+    return !(box.west <= box.east && box.south <= box.north);
+}
+
+// Remove from box the part of it that intersects other. The result must be
+// a box, so this may remove more than the intersection: the largest of the
+// parts of box on each side of other is kept.
+static void subtractFromBox(GridAtBox &box, const GridAtBox &other) {
+    if (other.east < box.west || other.west > box.east ||
+        other.north < box.south || other.south > box.north) {
+        return;
+    }
+    GridAtBox candidates[4] = {box, box, box, box};
+    candidates[0].east = other.west;
+    candidates[1].west = other.east;
+    candidates[2].north = other.south;
+    candidates[3].south = other.north;
+    double bestArea = -1;
+    for (const auto &candidate : candidates) {
+        if (isBoxEmpty(candidate))
+            continue;
+        const double area = (candidate.east - candidate.west) *
+                            (candidate.north - candidate.south);
+        if (area > bestArea) {
+            bestArea = area;
+            box = candidate;
+        }
+    }
+    if (bestArea < 0) {
+        box.west = 1;
+        box.east = 0;
+    }
+}
+
+// Remove from box the points for which isPointInExtent(x, y, extent, eps)
+// may succeed, including through longitude wrapping. A small margin covers
+// rounding errors in isPointInExtent().
+static void subtractExtentFromBox(GridAtBox &box, const ExtentAndRes &extent,
+                                  double eps) {
+    const auto lower = [](double v) { return v - (std::fabs(v) + 1) * 1e-12; };
+    const auto upper = [](double v) { return v + (std::fabs(v) + 1) * 1e-12; };
+    GridAtBox other;
+    other.south = lower(extent.south - eps);
+    other.north = upper(extent.north + eps);
+    if (extent.fullWorldLongitude()) {
+        other.west = -GRID_AT_BOX_UNBOUNDED;
+        other.east = GRID_AT_BOX_UNBOUNDED;
+        subtractFromBox(box, other);
+        return;
+    }
+    other.west = lower(extent.west - eps);
+    other.east = upper(extent.east + eps);
+    subtractFromBox(box, other);
+    if (extent.isGeographic) {
+        for (const double shift : {-2 * M_PI, 2 * M_PI}) {
+            GridAtBox shifted = other;
+            shifted.west += shift;
+            shifted.east += shift;
+            subtractFromBox(box, shifted);
+        }
+    }
+}
+
+// Search a grid set for the grid to use at (x, y), as
+// HorizontalShiftGridSet::gridAt() & co do, but with a cache of the last
+// result. Top-level grids for which skip() returns true are ignored, and
+// epsilonOf() returns the tolerance of isPointInExtent() for an extent.
+//
+// On a cache miss, the box stored in the cache is computed from the path
+// followed in the grid hierarchy: points in it are in the extent of all grids
+// of the path (without tolerance nor longitude wrapping), and in none of
+// the extents of the grids visited before them, so that the search would
+// follow the same path.
+template <class GridType, class SkipFunc, class EpsilonFunc>
+static const GridType *
+gridAtWithCache(const std::vector<std::unique_ptr<GridType>> &grids,
+                double x, double y, SkipFunc skip, EpsilonFunc epsilonOf,
+                GridAtCache &cache) {
+    if (cache.grid != nullptr && x >= cache.west && x <= cache.east &&
+        y >= cache.south && y <= cache.north) {
+        return static_cast<const GridType *>(cache.grid)->gridAt(x, y);
+    }
+
+    constexpr int MAX_CACHED_DEPTH = 8;
+    const std::vector<std::unique_ptr<GridType>> *levels[MAX_CACHED_DEPTH];
+    size_t indices[MAX_CACHED_DEPTH];
+    int depth = 0;
+
+    const GridType *found = nullptr;
+    for (size_t i = 0; i < grids.size(); ++i) {
+        const auto &grid = grids[i];
+        if (grid->isNullGrid()) {
+            return grid.get();
+        }
+        if (skip(grid.get())) {
+            continue;
+        }
+        const auto &extent = grid->extentAndRes();
+        if (isPointInExtent(x, y, extent, epsilonOf(extent))) {
+            found = grid.get();
+            levels[0] = &grids;
+            indices[0] = i;
+            depth = 1;
+            break;
+        }
+    }
+    if (found == nullptr) {
+        return nullptr;
+    }
+
+    for (bool descended = true; descended;) {
+        descended = false;
+        const auto &children = found->children();
+        for (size_t i = 0; i < children.size(); ++i) {
+            const auto &extentChild = children[i]->extentAndRes();
+            if (isPointInExtent(x, y, extentChild, epsilonOf(extentChild))) {
+                if (depth < MAX_CACHED_DEPTH) {
+                    levels[depth] = &children;
+                    indices[depth] = i;
+                }
+                ++depth;
+                found = children[i].get();
+                descended = true;
+                break;
+            }
+        }
+    }
+
+    cache.grid = nullptr;
+    if (depth > MAX_CACHED_DEPTH) {
+        return found;
+    }
+    GridAtBox box = {-GRID_AT_BOX_UNBOUNDED, -GRID_AT_BOX_UNBOUNDED,
+                     GRID_AT_BOX_UNBOUNDED, GRID_AT_BOX_UNBOUNDED};
+    for (int level = 0; level < depth && !isBoxEmpty(box); ++level) {
+        const auto &siblings = *levels[level];
+        const size_t index = indices[level];
+        const auto &extent = siblings[index]->extentAndRes();
+        box.south = std::max(box.south, extent.south);
+        box.north = std::min(box.north, extent.north);
+        if (!extent.fullWorldLongitude()) {
+            box.west = std::max(box.west, extent.west);
+            box.east = std::min(box.east, extent.east);
+        }
+        for (size_t j = 0; j < index; ++j) {
+            if (level == 0 && skip(siblings[j].get())) {
+                continue;
+            }
+            const auto &extentSibling = siblings[j]->extentAndRes();
+            subtractExtentFromBox(box, extentSibling,
+                                  epsilonOf(extentSibling));
+        }
+    }
+    if (!isBoxEmpty(box)) {
+        cache.grid = found;
+        cache.west = box.west;
+        cache.south = box.south;
+        cache.east = box.east;
+        cache.north = box.north;
+    }
+    return found;
+}
+
+// ---------------------------------------------------------------------------
+
 const VerticalShiftGrid *VerticalShiftGrid::gridAt(double longitude,
                                                    double lat) const {
     for (const auto &child : m_children) {
@@ -1720,16 +2192,10 @@ const VerticalShiftGrid *VerticalShiftGrid::gridAt(double longitude,
 
 const VerticalShiftGrid *VerticalShiftGridSet::gridAt(double longitude,
                                                       double lat) const {
-    for (const auto &grid : m_grids) {
-        if (grid->isNullGrid()) {
-            return grid.get();
-        }
-        const auto &extent = grid->extentAndRes();
-        if (isPointInExtent(longitude, lat, extent)) {
-            return grid->gridAt(longitude, lat);
-        }
-    }
-    return nullptr;
+    return gridAtWithCache(
+        m_grids, longitude, lat,
+        [](const VerticalShiftGrid *) { return false; },
+        [](const ExtentAndRes &) { return 0.0; }, m_lastGridAt);
 }
 
 // ---------------------------------------------------------------------------
@@ -1753,6 +2219,22 @@ HorizontalShiftGrid::~HorizontalShiftGrid() = default;
 
 // ---------------------------------------------------------------------------
 
+bool HorizontalShiftGrid::valuesAt(int x_start, int y_start, int x_count,
+                                   int y_count, bool compensateNTConvention,
+                                   float *longShift, float *latShift) const {
+    for (int y = y_start; y < y_start + y_count; ++y) {
+        for (int x = x_start; x < x_start + x_count; ++x) {
+            if (!valueAt(x, y, compensateNTConvention, *longShift, *latShift))
+                return false;
+            ++longShift;
+            ++latShift;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
 HorizontalShiftGridSet::HorizontalShiftGridSet() = default;
 
 // ---------------------------------------------------------------------------
@@ -1937,6 +2419,7 @@ bool NTv1Grid::valueAt(int x, int y, bool compensateNTConvention,
 class CTable2Grid : public HorizontalShiftGrid {
     PJ_CONTEXT *m_ctx;
     std::unique_ptr<File> m_fp;
+    const unsigned char *m_mappedData; // set if m_fp is memory-mapped
 
     CTable2Grid(const CTable2Grid &) = delete;
     CTable2Grid &operator=(const CTable2Grid &) = delete;
@@ -1946,7 +2429,10 @@ class CTable2Grid : public HorizontalShiftGrid {
                 const std::string &nameIn, int widthIn, int heightIn,
                 const ExtentAndRes &extentIn)
         : HorizontalShiftGrid(nameIn, widthIn, heightIn, extentIn), m_ctx(ctx),
-          m_fp(std::move(fp)) {}
+          m_fp(std::move(fp)),
+          m_mappedData(static_cast<const unsigned char *>(
+              m_fp->mappedRange(160, 2 * sizeof(float) * widthIn *
+                                         static_cast<size_t>(heightIn)))) {}
 
     ~CTable2Grid() override;
 
@@ -2036,11 +2522,18 @@ bool CTable2Grid::valueAt(int x, int y, bool compensateNTConvention,
     assert(x >= 0 && y >= 0 && x < m_width && y < m_height);
 
     float two_floats[2];
-    m_fp->seek(160 + 2 * sizeof(float) * (y * m_width + x));
-    if (m_fp->read(&two_floats[0], sizeof(two_floats)) != sizeof(two_floats)) {
-        proj_context_errno_set(m_ctx,
-                               PROJ_ERR_INVALID_OP_FILE_NOT_FOUND_OR_INVALID);
-        return false;
+    const size_t offset =
+        2 * sizeof(float) * (static_cast<size_t>(y) * m_width + x);
+    if (m_mappedData) {
+        memcpy(&two_floats[0], m_mappedData + offset, sizeof(two_floats));
+    } else {
+        m_fp->seek(160 + offset);
+        if (m_fp->read(&two_floats[0], sizeof(two_floats)) !=
+            sizeof(two_floats)) {
+            proj_context_errno_set(
+                m_ctx, PROJ_ERR_INVALID_OP_FILE_NOT_FOUND_OR_INVALID);
+            return false;
+        }
     }
     if (!IS_LSB) {
         swap_words(&two_floats[0], sizeof(float), 2);
@@ -2057,7 +2550,6 @@ bool CTable2Grid::valueAt(int x, int y, bool compensateNTConvention,
 
 class NTv2GridSet : public HorizontalShiftGridSet {
     std::unique_ptr<File> m_fp;
-    std::unique_ptr<FloatLineCache> m_cache{};
 
     NTv2GridSet(const NTv2GridSet &) = delete;
     NTv2GridSet &operator=(const NTv2GridSet &) = delete;
@@ -2082,41 +2574,109 @@ class NTv2GridSet : public HorizontalShiftGridSet {
 class NTv2Grid : public HorizontalShiftGrid {
     friend class NTv2GridSet;
 
-    PJ_CONTEXT *m_ctx;                 // owned by the parent NTv2GridSet
-    File *m_fp;                        // owned by the parent NTv2GridSet
-    FloatLineCache *m_cache = nullptr; // owned by the parent NTv2GridSet
+    PJ_CONTEXT *m_ctx; // owned by the parent NTv2GridSet
+    File *m_fp;        // owned by the parent NTv2GridSet
+    uint64_t m_fileId;
     uint32_t m_gridIdx;
     unsigned long long m_offset;
+    const unsigned char *m_mappedData; // set if m_fp is memory-mapped
     bool m_mustSwap;
     mutable std::vector<float> m_buffer{};
+    mutable GridBlockCache::Block m_line{};
+    mutable int m_lineIdx = -1;
+
+    const float *lineAt(int y) const;
 
     NTv2Grid(const NTv2Grid &) = delete;
     NTv2Grid &operator=(const NTv2Grid &) = delete;
 
   public:
     NTv2Grid(const std::string &nameIn, PJ_CONTEXT *ctx, File *fp,
-             uint32_t gridIdx, unsigned long long offsetIn, bool mustSwapIn,
-             int widthIn, int heightIn, const ExtentAndRes &extentIn)
+             uint64_t fileId, uint32_t gridIdx, unsigned long long offsetIn,
+             bool mustSwapIn, int widthIn, int heightIn,
+             const ExtentAndRes &extentIn)
         : HorizontalShiftGrid(nameIn, widthIn, heightIn, extentIn), m_ctx(ctx),
-          m_fp(fp), m_gridIdx(gridIdx), m_offset(offsetIn),
+          m_fp(fp), m_fileId(fileId), m_gridIdx(gridIdx), m_offset(offsetIn),
+          m_mappedData(static_cast<const unsigned char *>(
+              fp->mappedRange(offsetIn, 4 * sizeof(float) * widthIn *
+                                            static_cast<size_t>(heightIn)))),
           m_mustSwap(mustSwapIn) {}
 
     bool valueAt(int, int, bool, float &longShift,
                  float &latShift) const override;
+    bool valuesAt(int x_start, int y_start, int x_count, int y_count,
+                  bool compensateNTConvention, float *longShift,
+                  float *latShift) const override;
 
     const std::string &metadataItem(const std::string &, int) const override {
         return emptyString;
     }
 
-    void setCache(FloatLineCache *cache) { m_cache = cache; }
-
     void reassign_context(PJ_CONTEXT *ctx) override {
         m_ctx = ctx;
         m_fp->reassign_context(ctx);
     }
-
-    bool hasChanged() const override { return m_fp->hasChanged(); }
-};
+
+    bool hasChanged() const override { return m_fp->hasChanged(); }
+};
+
+// ---------------------------------------------------------------------------
+
+const float *NTv2Grid::lineAt(int y) const {
+    if (y != m_lineIdx) {
+        auto line = gGridBlockCache.get(m_fileId, m_gridIdx, y);
+        if (line == nullptr) {
+            try {
+                m_buffer.resize(4 * m_width);
+            } catch (const std::exception &e) {
+                pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
+                return nullptr;
+            }
+
+            const size_t nLineSizeInBytes = 4 * sizeof(float) * m_width;
+            // there are 4 components: lat shift, long shift, lat error, long
+            // error
+            m_fp->seek(m_offset +
+                       nLineSizeInBytes * static_cast<unsigned long long>(y));
+            if (m_fp->read(&m_buffer[0], nLineSizeInBytes) !=
+                nLineSizeInBytes) {
+                proj_context_errno_set(
+                    m_ctx, PROJ_ERR_INVALID_OP_FILE_NOT_FOUND_OR_INVALID);
+                return nullptr;
+            }
+            if (m_mustSwap) {
+                swap_words(&m_buffer[0], sizeof(float), 4 * m_width);
+            }
+
+            // Remove lat and long error, and reorder from west to east, as
+            // NTv2 is organized from east to west !
+            std::shared_ptr<std::vector<unsigned char>> buffer;
+            try {
+                buffer = std::make_shared<std::vector<unsigned char>>(
+                    2 * sizeof(float) * m_width);
+            } catch (const std::exception &e) {
+                pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
+                return nullptr;
+            }
+            float *out = reinterpret_cast<float *>(buffer->data());
+            for (int i = 0; i < m_width; ++i) {
+                out[2 * i] = m_buffer[4 * (m_width - 1 - i)];
+                out[2 * i + 1] = m_buffer[4 * (m_width - 1 - i) + 1];
+            }
+
+            line = std::move(buffer);
+            try {
+                gGridBlockCache.insert(m_fileId, m_gridIdx, y, line);
+            } catch (const std::exception &e) {
+                // Should normally not happen
+                pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
+            }
+        }
+        m_line = std::move(line);
+        m_lineIdx = y;
+    }
+    return reinterpret_cast<const float *>(m_line->data());
+}
 
 // ---------------------------------------------------------------------------
 
@@ -2124,47 +2684,30 @@ bool NTv2Grid::valueAt(int x, int y, bool compensateNTConvention,
                        float &longShift, float &latShift) const {
     assert(x >= 0 && y >= 0 && x < m_width && y < m_height);
 
-    const std::vector<float> *pBuffer = m_cache->get(m_gridIdx, y);
-    if (pBuffer == nullptr) {
-        try {
-            m_buffer.resize(4 * m_width);
-        } catch (const std::exception &e) {
-            pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
-            return false;
-        }
-
-        const size_t nLineSizeInBytes = 4 * sizeof(float) * m_width;
-        // there are 4 components: lat shift, long shift, lat error, long error
-        m_fp->seek(m_offset +
-                   nLineSizeInBytes * static_cast<unsigned long long>(y));
-        if (m_fp->read(&m_buffer[0], nLineSizeInBytes) != nLineSizeInBytes) {
-            proj_context_errno_set(
-                m_ctx, PROJ_ERR_INVALID_OP_FILE_NOT_FOUND_OR_INVALID);
-            return false;
-        }
-        // Remove lat and long error
-        for (int i = 1; i < m_width; ++i) {
-            m_buffer[2 * i] = m_buffer[4 * i];
-            m_buffer[2 * i + 1] = m_buffer[4 * i + 1];
-        }
-        m_buffer.resize(2 * m_width);
+    if (m_mappedData) {
+        // there are 4 components: lat shift, long shift, lat error, long
+        // error, and NTv2 is organized from east to west !
+        float two_floats[2];
+        memcpy(&two_floats[0],
+               m_mappedData +
+                   4 * sizeof(float) *
+                       (static_cast<size_t>(y) * m_width + m_width - 1 - x),
+               sizeof(two_floats));
         if (m_mustSwap) {
-            swap_words(&m_buffer[0], sizeof(float), 2 * m_width);
-        }
-        // NTv2 is organized from east to west !
-        for (int i = 0; i < m_width / 2; ++i) {
-            std::swap(m_buffer[2 * i], m_buffer[2 * (m_width - 1 - i)]);
-            std::swap(m_buffer[2 * i + 1], m_buffer[2 * (m_width - 1 - i) + 1]);
-        }
-
-        try {
-            m_cache->insert(m_gridIdx, y, m_buffer);
-        } catch (const std::exception &e) {
-            // Should normally not happen
-            pj_log(m_ctx, PJ_LOG_ERROR, _("Exception %s"), e.what());
+            swap_words(&two_floats[0], sizeof(float), 2);
         }
+        latShift =
+            static_cast<float>(two_floats[0] * ((M_PI / 180.0) / 3600.0));
+        // west longitude positive convention !
+        longShift =
+            (compensateNTConvention ? -1 : 1) *
+            static_cast<float>(two_floats[1] * ((M_PI / 180.0) / 3600.0));
+        return true;
     }
-    const std::vector<float> &buffer = pBuffer ? *pBuffer : m_buffer;
+
+    const float *buffer = lineAt(y);
+    if (buffer == nullptr)
+        return false;
 
     /* convert seconds to radians */
     latShift = static_cast<float>(buffer[2 * x] * ((M_PI / 180.0) / 3600.0));
@@ -2177,6 +2720,51 @@ bool NTv2Grid::valueAt(int x, int y, bool compensateNTConvention,
 
 // ---------------------------------------------------------------------------
 
+bool NTv2Grid::valuesAt(int x_start, int y_start, int x_count, int y_count,
+                        bool compensateNTConvention, float *longShift,
+                        float *latShift) const {
+    assert(x_start >= 0 && y_start >= 0 && x_count >= 0 && y_count >= 0 &&
+           x_start + x_count <= m_width && y_start + y_count <= m_height);
+
+    constexpr double convFactor = (M_PI / 180.0) / 3600.0;
+    const int sign = compensateNTConvention ? -1 : 1;
+    for (int y = y_start; y < y_start + y_count; ++y) {
+        if (m_mappedData) {
+            // NTv2 is organized from east to west !
+            const unsigned char *ptr =
+                m_mappedData +
+                4 * sizeof(float) *
+                    (static_cast<size_t>(y) * m_width + m_width - 1 - x_start);
+            for (int x = 0; x < x_count; ++x) {
+                float two_floats[2];
+                memcpy(&two_floats[0], ptr, sizeof(two_floats));
+                if (m_mustSwap) {
+                    swap_words(&two_floats[0], sizeof(float), 2);
+                }
+                latShift[x] = static_cast<float>(two_floats[0] * convFactor);
+                longShift[x] =
+                    sign * static_cast<float>(two_floats[1] * convFactor);
+                ptr -= 4 * sizeof(float);
+            }
+        } else {
+            const float *buffer = lineAt(y);
+            if (buffer == nullptr)
+                return false;
+            buffer += 2 * x_start;
+            for (int x = 0; x < x_count; ++x) {
+                latShift[x] = static_cast<float>(buffer[2 * x] * convFactor);
+                longShift[x] =
+                    sign * static_cast<float>(buffer[2 * x + 1] * convFactor);
+            }
+        }
+        latShift += x_count;
+        longShift += x_count;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
 NTv2GridSet::~NTv2GridSet() = default;
 
 // ---------------------------------------------------------------------------
@@ -2231,7 +2819,7 @@ std::unique_ptr<NTv2GridSet> NTv2GridSet::open(PJ_CONTEXT *ctx,
     /* ==================================================================== */
     /*      Step through the subfiles, creating a grid for each.            */
     /* ==================================================================== */
-    int largestLine = 1;
+    const uint64_t fileId = gGridBlockCache.getFileId(fpRaw);
     for (unsigned subfile = 0; subfile < num_subfiles; subfile++) {
         // Read header
         if (fpRaw->read(header, sizeof(header)) != sizeof(header)) {
@@ -2293,8 +2881,6 @@ std::unique_ptr<NTv2GridSet> NTv2GridSet::open(PJ_CONTEXT *ctx,
             fabs((extent.east - extent.west) * extent.invResX + 0.5) + 1);
         const int rows = static_cast<int>(
             fabs((extent.north - extent.south) * extent.invResY + 0.5) + 1);
-        if (columns > largestLine)
-            largestLine = columns;
 
         pj_log(ctx, PJ_LOG_TRACE,
                "NTv2 %s %dx%d: LL=(%.9g,%.9g) UR=(%.9g,%.9g)", gridName.c_str(),
@@ -2316,7 +2902,7 @@ std::unique_ptr<NTv2GridSet> NTv2GridSet::open(PJ_CONTEXT *ctx,
         const auto offset = fpRaw->tell();
         auto grid = std::unique_ptr<NTv2Grid>(new NTv2Grid(
             std::string(filename).append(", ").append(gridName), ctx, fpRaw,
-            subfile, offset, must_swap, columns, rows, extent));
+            fileId, subfile, offset, must_swap, columns, rows, extent));
         std::string parentName;
         parentName.assign(header + 24, 8);
         auto iter = mapGrids.find(parentName);
@@ -2333,13 +2919,6 @@ std::unique_ptr<NTv2GridSet> NTv2GridSet::open(PJ_CONTEXT *ctx,
                     SEEK_CUR);
     }
 
-    // Cache up to 1 megapixel per NTv2 file
-    const int maxLinesInCache = 1024 * 1024 / largestLine;
-    set->m_cache = std::make_unique<FloatLineCache>(maxLinesInCache);
-    for (const auto &kv : mapGrids) {
-        kv.second->setCache(set->m_cache.get());
-    }
-
     return set;
 }
 
@@ -2410,6 +2989,8 @@ class GTiffHGrid : public HorizontalShiftGrid {
 
     bool valueAt(int x, int y, bool, float &longShift,
                  float &latShift) const override;
+    bool valuesAt(int x_start, int y_start, int x_count, int y_count, bool,
+                  float *longShift, float *latShift) const override;
 
     const std::string &metadataItem(const std::string &key,
                                     int sample = -1) const override {
@@ -2463,6 +3044,37 @@ bool GTiffHGrid::valueAt(int x, int y, bool, float &longShift,
 
 // ---------------------------------------------------------------------------
 
+bool GTiffHGrid::valuesAt(int x_start, int y_start, int x_count, int y_count,
+                          bool, float *longShift, float *latShift) const {
+    // Fetch both samples of each node at once, in the order they are
+    // generally stored in the grid
+    const int sampleIdx[2] = {m_idxLatShift, m_idxLongShift};
+    std::vector<float> shifts;
+    try {
+        shifts.resize(2 * static_cast<size_t>(x_count) * y_count);
+    } catch (const std::exception &) {
+        return false;
+    }
+    bool nodataFound = false;
+    if (!m_grid->valuesAt(x_start, y_start, x_count, y_count, 2, sampleIdx,
+                          shifts.data(), nodataFound)) {
+        return false;
+    }
+    const size_t count = static_cast<size_t>(x_count) * y_count;
+    for (size_t i = 0; i < count; ++i) {
+        // From arc-seconds to radians
+        latShift[i] = static_cast<float>(shifts[2 * i] * m_convFactorToRadian);
+        longShift[i] =
+            static_cast<float>(shifts[2 * i + 1] * m_convFactorToRadian);
+        if (!m_positiveEast) {
+            longShift[i] = -longShift[i];
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+
 void GTiffHGrid::insertGrid(PJ_CONTEXT *ctx,
                             std::unique_ptr<GTiffHGrid> &&subgrid) {
     bool gridInserted = false;
@@ -2747,7 +3359,9 @@ HorizontalShiftGridSet::open(PJ_CONTEXT *ctx, const std::string &filename) {
 bool HorizontalShiftGridSet::reopen(PJ_CONTEXT *ctx) {
     pj_log(ctx, PJ_LOG_DEBUG, "Grid %s has changed. Re-loading it",
            m_name.c_str());
+    gGridBlockCache.clear();
     auto newGS = open(ctx, m_name);
+    m_lastGridAt = GridAtCache();
     m_grids.clear();
     if (newGS) {
         m_grids = std::move(newGS->m_grids);
@@ -2775,18 +3389,13 @@ const HorizontalShiftGrid *HorizontalShiftGrid::gridAt(double longitude,
 
 const HorizontalShiftGrid *HorizontalShiftGridSet::gridAt(double longitude,
                                                           double lat) const {
-    for (const auto &grid : m_grids) {
-        if (grid->isNullGrid()) {
-            return grid.get();
-        }
-        const auto &extent = grid->extentAndRes();
-        const double epsilon =
-            (extent.resX + extent.resY) * REL_TOLERANCE_HGRIDSHIFT;
-        if (isPointInExtent(longitude, lat, extent, epsilon)) {
-            return grid->gridAt(longitude, lat);
-        }
-    }
-    return nullptr;
+    return gridAtWithCache(
+        m_grids, longitude, lat,
+        [](const HorizontalShiftGrid *) { return false; },
+        [](const ExtentAndRes &extent) {
+            return (extent.resX + extent.resY) * REL_TOLERANCE_HGRIDSHIFT;
+        },
+        m_lastGridAt);
 }
 
 // ---------------------------------------------------------------------------
@@ -3147,7 +3756,10 @@ GenericShiftGridSet::open(PJ_CONTEXT *ctx, const std::string &filename) {
 bool GenericShiftGridSet::reopen(PJ_CONTEXT *ctx) {
     pj_log(ctx, PJ_LOG_DEBUG, "Grid %s has changed. Re-loading it",
            m_name.c_str());
+    gGridBlockCache.clear();
     auto newGS = open(ctx, m_name);
+    m_lastGridAt = GridAtCache();
+    m_lastGridAtType = GridAtCache();
     m_grids.clear();
     if (newGS) {
         m_grids = std::move(newGS->m_grids);
@@ -3170,35 +3782,23 @@ const GenericShiftGrid *GenericShiftGrid::gridAt(double x, double y) const {
 // ---------------------------------------------------------------------------
 
 const GenericShiftGrid *GenericShiftGridSet::gridAt(double x, double y) const {
-    for (const auto &grid : m_grids) {
-        if (grid->isNullGrid()) {
-            return grid.get();
-        }
-        const auto &extent = grid->extentAndRes();
-        if (isPointInExtent(x, y, extent)) {
-            return grid->gridAt(x, y);
-        }
-    }
-    return nullptr;
+    return gridAtWithCache(
+        m_grids, x, y, [](const GenericShiftGrid *) { return false; },
+        [](const ExtentAndRes &) { return 0.0; }, m_lastGridAt);
 }
 
 // ---------------------------------------------------------------------------
 
 const GenericShiftGrid *GenericShiftGridSet::gridAt(const std::string &type,
                                                     double x, double y) const {
-    for (const auto &grid : m_grids) {
-        if (grid->isNullGrid()) {
-            return grid.get();
-        }
-        if (grid->type() != type) {
-            continue;
-        }
-        const auto &extent = grid->extentAndRes();
-        if (isPointInExtent(x, y, extent)) {
-            return grid->gridAt(x, y);
-        }
-    }
-    return nullptr;
+    if (type != m_lastType) {
+        m_lastType = type;
+        m_lastGridAtType.grid = nullptr;
+    }
+    return gridAtWithCache(
+        m_grids, x, y,
+        [&type](const GenericShiftGrid *grid) { return grid->type() != type; },
+        [](const ExtentAndRes &) { return 0.0; }, m_lastGridAtType);
 }
 
 // ---------------------------------------------------------------------------
@@ -3322,9 +3922,80 @@ typedef struct {
     int32_t lam, phi;
 } ILP;
 
+// Node accessor of pj_hgrid_interpolate() reading directly from the grid
+struct HGridNodeReader {
+    bool valueAt(const HorizontalShiftGrid *grid, int x, int y,
+                 bool compensateNTConvention, float &longShift,
+                 float &latShift) const {
+        return grid->valueAt(x, y, compensateNTConvention, longShift,
+                             latShift);
+    }
+
+    void invalidate() {}
+};
+
+// Node accessor of pj_hgrid_interpolate() used by pj_hgrid_apply_batch():
+// the shifts of a window of nodes of a grid are fetched at once with
+// valuesAt(), and nodes outside of that window are read from the grid.
+struct HGridNodeWindow {
+    const HorizontalShiftGrid *grid = nullptr;
+    bool compensateNTConvention = false;
+    int xStart = 0;
+    int yStart = 0;
+    int xCount = 0;
+    int yCount = 0;
+    std::vector<float> longShifts{};
+    std::vector<float> latShifts{};
+
+    bool fetch(const HorizontalShiftGrid *gridIn, int xStartIn, int yStartIn,
+               int xCountIn, int yCountIn, bool compensateNTConventionIn) {
+        invalidate();
+        const size_t count = static_cast<size_t>(xCountIn) * yCountIn;
+        if (longShifts.size() < count) {
+            longShifts.resize(count);
+            latShifts.resize(count);
+        }
+        if (!gridIn->valuesAt(xStartIn, yStartIn, xCountIn, yCountIn,
+                              compensateNTConventionIn, longShifts.data(),
+                              latShifts.data())) {
+            return false;
+        }
+        grid = gridIn;
+        compensateNTConvention = compensateNTConventionIn;
+        xStart = xStartIn;
+        yStart = yStartIn;
+        xCount = xCountIn;
+        yCount = yCountIn;
+        return true;
+    }
+
+    bool valueAt(const HorizontalShiftGrid *gridIn, int x, int y,
+                 bool compensateNTConventionIn, float &longShift,
+                 float &latShift) const {
+        const int dx = x - xStart;
+        const int dy = y - yStart;
+        if (gridIn == grid &&
+            compensateNTConventionIn == compensateNTConvention && dx >= 0 &&
+            dx < xCount && dy >= 0 && dy < yCount) {
+            const size_t idx = static_cast<size_t>(dy) * xCount + dx;
+            longShift = longShifts[idx];
+            latShift = latShifts[idx];
+            return true;
+        }
+        return gridIn->valueAt(x, y, compensateNTConventionIn, longShift,
+                               latShift);
+    }
+
+    void invalidate() { grid = nullptr; }
+};
+
+// ---------------------------------------------------------------------------
+
 // Apply bilinear interpolation for horizontal shift grids
+template <class NodeAccessor>
 static PJ_LP pj_hgrid_interpolate(PJ_LP t, const HorizontalShiftGrid *grid,
-                                  bool compensateNTConvention) {
+                                  bool compensateNTConvention,
+                                  const NodeAccessor &nodes) {
     PJ_LP val, frct;
     ILP indx;
     int in;
@@ -3369,14 +4040,14 @@ static PJ_LP pj_hgrid_interpolate(PJ_LP t, const HorizontalShiftGrid *grid,
     float f10Long = 0, f10Lat = 0;
     float f01Long = 0, f01Lat = 0;
     float f11Long = 0, f11Lat = 0;
-    if (!grid->valueAt(indx.lam, indx.phi, compensateNTConvention, f00Long,
-                       f00Lat) ||
-        !grid->valueAt(indx.lam + 1, indx.phi, compensateNTConvention, f10Long,
-                       f10Lat) ||
-        !grid->valueAt(indx.lam, indx.phi + 1, compensateNTConvention, f01Long,
-                       f01Lat) ||
-        !grid->valueAt(indx.lam + 1, indx.phi + 1, compensateNTConvention,
-                       f11Long, f11Lat)) {
+    if (!nodes.valueAt(grid, indx.lam, indx.phi, compensateNTConvention,
+                       f00Long, f00Lat) ||
+        !nodes.valueAt(grid, indx.lam + 1, indx.phi, compensateNTConvention,
+                       f10Long, f10Lat) ||
+        !nodes.valueAt(grid, indx.lam, indx.phi + 1, compensateNTConvention,
+                       f01Long, f01Lat) ||
+        !nodes.valueAt(grid, indx.lam + 1, indx.phi + 1,
+                       compensateNTConvention, f11Long, f11Lat)) {
         return val;
     }
 
@@ -3396,15 +4067,24 @@ static PJ_LP pj_hgrid_interpolate(PJ_LP t, const HorizontalShiftGrid *grid,
 
 // ---------------------------------------------------------------------------
 
+static PJ_LP pj_hgrid_interpolate(PJ_LP t, const HorizontalShiftGrid *grid,
+                                  bool compensateNTConvention) {
+    return pj_hgrid_interpolate(t, grid, compensateNTConvention,
+                                HGridNodeReader());
+}
+
+// ---------------------------------------------------------------------------
+
 #define MAX_ITERATIONS 10
 #define TOL 1e-12
 
+template <class NodeAccessor>
 static PJ_LP pj_hgrid_apply_internal(PJ_CONTEXT *ctx, PJ_LP in,
                                      PJ_DIRECTION direction,
                                      const HorizontalShiftGrid *grid,
                                      HorizontalShiftGridSet *gridset,
                                      const ListOfHGrids &grids,
-                                     bool &shouldRetry) {
+                                     bool &shouldRetry, NodeAccessor &nodes) {
     PJ_LP t, tb, del, dif;
     int i = MAX_ITERATIONS;
     const double toltol = TOL * TOL;
@@ -3425,8 +4105,9 @@ static PJ_LP pj_hgrid_apply_internal(PJ_CONTEXT *ctx, PJ_LP in,
         tb.lam -= 2 * M_PI;
     tb.phi -= extent->south;
 
-    t = pj_hgrid_interpolate(tb, grid, true);
+    t = pj_hgrid_interpolate(tb, grid, true, nodes);
     if (grid->hasChanged()) {
+        nodes.invalidate();
         shouldRetry = gridset->reopen(ctx);
         return t;
     }
@@ -3443,8 +4124,9 @@ static PJ_LP pj_hgrid_apply_internal(PJ_CONTEXT *ctx, PJ_LP in,
     t.phi = tb.phi - t.phi;
 
     do {
-        del = pj_hgrid_interpolate(t, grid, true);
+        del = pj_hgrid_interpolate(t, grid, true, nodes);
         if (grid->hasChanged()) {
+            nodes.invalidate();
             shouldRetry = gridset->reopen(ctx);
             return t;
         }
@@ -3525,8 +4207,9 @@ PJ_LP pj_hgrid_apply(PJ_CONTEXT *ctx, const ListOfHGrids &grids, PJ_LP lp,
         }
 
         bool shouldRetry = false;
+        HGridNodeReader nodes;
         out = pj_hgrid_apply_internal(ctx, lp, direction, grid, gridset, grids,
-                                      shouldRetry);
+                                      shouldRetry, nodes);
         if (!shouldRetry) {
             break;
         }
@@ -3538,6 +4221,135 @@ PJ_LP pj_hgrid_apply(PJ_CONTEXT *ctx, const ListOfHGrids &grids, PJ_LP lp,
     return out;
 }
 
+// ---------------------------------------------------------------------------
+
+// Maximum number of nodes whose values are fetched at once for a run of
+// points of pj_hgrid_apply_batch() or pj_vgrid_apply_batch()
+#define MAX_BATCH_WINDOW_NODES 4096
+
+// Bounding box of the cells of a grid in which a run of points fall
+struct GridCellBox {
+    int xMin = std::numeric_limits<int>::max();
+    int yMin = std::numeric_limits<int>::max();
+    int xMax = std::numeric_limits<int>::min();
+    int yMax = std::numeric_limits<int>::min();
+
+    // x and y are the position of the point in the grid, in nodes. Points
+    // outside of the grid are ignored, and will read the grid directly.
+    void add(const Grid *grid, double x, double y) {
+        if (!(x >= 0 && x < grid->width() && y >= 0 && y < grid->height()))
+            return;
+        const int ix = static_cast<int>(x);
+        const int iy = static_cast<int>(y);
+        xMin = std::min(xMin, ix);
+        yMin = std::min(yMin, iy);
+        xMax = std::max(xMax, ix);
+        yMax = std::max(yMax, iy);
+    }
+
+    // Window of nodes around the cells, extended by margin nodes in each
+    // direction. Returns false if it is empty or too large.
+    bool getWindow(const Grid *grid, int margin, int &xStart, int &yStart,
+                   int &xCount, int &yCount) const {
+        if (xMin > xMax)
+            return false;
+        xStart = std::max(0, xMin - margin);
+        yStart = std::max(0, yMin - margin);
+        xCount = std::min(grid->width() - 1, xMax + 1 + margin) - xStart + 1;
+        yCount = std::min(grid->height() - 1, yMax + 1 + margin) - yStart + 1;
+        return static_cast<size_t>(xCount) * yCount <= MAX_BATCH_WINDOW_NODES;
+    }
+};
+
+// ---------------------------------------------------------------------------
+
+/** Batched version of pj_hgrid_apply(), on the lp component of the n points
+ * of coo, skipping the ones whose first component is HUGE_VAL. Points that
+ * cannot be transformed are set to HUGE_VAL, and the error code, if any, is
+ * stored in errors.
+ *
+ * Consecutive points that fall in the same grid are processed together: the
+ * shifts of the nodes around them are fetched at once, and the interpolation
+ * then runs on that window of nodes. Results are the same as with
+ * pj_hgrid_apply().
+ */
+void pj_hgrid_apply_batch(PJ_CONTEXT *ctx, const ListOfHGrids &grids,
+                          PJ_COORD *coo, size_t n, int *errors,
+                          PJ_DIRECTION direction) {
+    HGridNodeWindow window;
+    size_t i = 0;
+    while (i < n) {
+        if (coo[i].v[0] == HUGE_VAL) {
+            ++i;
+            continue;
+        }
+
+        /* Gather the run of points that fall in the grid of the first one */
+        window.invalidate();
+        HorizontalShiftGridSet *gridset = nullptr;
+        const auto grid = findGrid(grids, coo[i].lp, gridset);
+        size_t end = i + 1;
+        if (grid && !grid->isNullGrid()) {
+            const auto &extent = grid->extentAndRes();
+            const double epsilon =
+                (extent.resX + extent.resY) * REL_TOLERANCE_HGRIDSHIFT;
+            GridCellBox box;
+            for (end = i; end < n; ++end) {
+                const PJ_LP lp = coo[end].lp;
+                if (lp.lam == HUGE_VAL)
+                    continue;
+                HorizontalShiftGridSet *otherGridset = nullptr;
+                if (end > i && findGrid(grids, lp, otherGridset) != grid)
+                    break;
+                double lam = lp.lam - extent.west;
+                if (lam + epsilon < 0)
+                    lam += 2 * M_PI;
+                else if (lam - epsilon > extent.east - extent.west)
+                    lam -= 2 * M_PI;
+                box.add(grid, lam / extent.resX,
+                        (lp.phi - extent.south) / extent.resY);
+            }
+
+            /* The inverse iterates around the point, so take a margin */
+            int xStart = 0, yStart = 0, xCount = 0, yCount = 0;
+            if (box.getWindow(grid, direction == PJ_INV ? 1 : 0, xStart,
+                              yStart, xCount, yCount)) {
+                window.fetch(grid, xStart, yStart, xCount, yCount, true);
+            }
+        }
+
+        for (size_t k = i; k < end; ++k) {
+            PJ_COORD &point = coo[k];
+            if (point.v[0] == HUGE_VAL)
+                continue;
+            ctx->last_errno = 0;
+
+            PJ_LP out;
+            bool done = false;
+            if (window.grid != nullptr) {
+                bool shouldRetry = false;
+                out = pj_hgrid_apply_internal(ctx, point.lp, direction, grid,
+                                              gridset, grids, shouldRetry,
+                                              window);
+                done = !shouldRetry;
+                if (done && (out.lam == HUGE_VAL || out.phi == HUGE_VAL))
+                    proj_context_errno_set(ctx,
+                                           PROJ_ERR_COORD_TRANSFM_OUTSIDE_GRID);
+            }
+            if (!done)
+                out = pj_hgrid_apply(ctx, grids, point.lp, direction);
+
+            point.lp = out;
+            if (ctx->last_errno) {
+                errors[k] = ctx->last_errno;
+                point = proj_coord_error();
+            }
+        }
+        i = end;
+    }
+    ctx->last_errno = 0;
+}
+
 /********************************************/
 /*           proj_hgrid_value()             */
 /*                                          */
@@ -3590,8 +4402,80 @@ PJ_LP pj_hgrid_value(PJ *P, const ListOfHGrids &grids, PJ_LP lp) {
 
 // ---------------------------------------------------------------------------
 
+static const VerticalShiftGrid *findVGrid(const ListOfVGrids &grids,
+                                          const PJ_LP &input,
+                                          VerticalShiftGridSet *&gridSetOut) {
+    for (const auto &gridset : grids) {
+        auto grid = gridset->gridAt(input.lam, input.phi);
+        if (grid) {
+            gridSetOut = gridset.get();
+            return grid;
+        }
+    }
+    return nullptr;
+}
+
+// ---------------------------------------------------------------------------
+
+// Node accessor of read_vgrid_value() reading directly from the grid
+struct VGridNodeReader {
+    bool valueAt(const VerticalShiftGrid *grid, int x, int y,
+                 float &out) const {
+        return grid->valueAt(x, y, out);
+    }
+
+    void invalidate() {}
+};
+
+// Node accessor of read_vgrid_value() used by pj_vgrid_apply_batch(), see
+// HGridNodeWindow
+struct VGridNodeWindow {
+    const VerticalShiftGrid *grid = nullptr;
+    int xStart = 0;
+    int yStart = 0;
+    int xCount = 0;
+    int yCount = 0;
+    std::vector<float> values{};
+
+    bool fetch(const VerticalShiftGrid *gridIn, int xStartIn, int yStartIn,
+               int xCountIn, int yCountIn) {
+        invalidate();
+        const size_t count = static_cast<size_t>(xCountIn) * yCountIn;
+        if (values.size() < count)
+            values.resize(count);
+        if (!gridIn->valuesAt(xStartIn, yStartIn, xCountIn, yCountIn,
+                              values.data())) {
+            return false;
+        }
+        grid = gridIn;
+        xStart = xStartIn;
+        yStart = yStartIn;
+        xCount = xCountIn;
+        yCount = yCountIn;
+        return true;
+    }
+
+    bool valueAt(const VerticalShiftGrid *gridIn, int x, int y,
+                 float &out) const {
+        const int dx = x - xStart;
+        const int dy = y - yStart;
+        if (gridIn == grid && dx >= 0 && dx < xCount && dy >= 0 &&
+            dy < yCount) {
+            out = values[static_cast<size_t>(dy) * xCount + dx];
+            return true;
+        }
+        return gridIn->valueAt(x, y, out);
+    }
+
+    void invalidate() { grid = nullptr; }
+};
+
+// ---------------------------------------------------------------------------
+
+template <class NodeAccessor>
 static double read_vgrid_value(PJ_CONTEXT *ctx, const ListOfVGrids &grids,
-                               const PJ_LP &input, const double vmultiplier) {
+                               const PJ_LP &input, const double vmultiplier,
+                               NodeAccessor &nodes) {
 
     /* do not deal with NaN coordinates */
     /* cppcheck-suppress duplicateExpression */
@@ -3600,14 +4484,7 @@ static double read_vgrid_value(PJ_CONTEXT *ctx, const ListOfVGrids &grids,
     }
 
     VerticalShiftGridSet *curGridset = nullptr;
-    const VerticalShiftGrid *grid = nullptr;
-    for (const auto &gridset : grids) {
-        grid = gridset->gridAt(input.lam, input.phi);
-        if (grid) {
-            curGridset = gridset.get();
-            break;
-        }
-    }
+    const VerticalShiftGrid *grid = findVGrid(grids, input, curGridset);
     if (!grid) {
         proj_context_errno_set(ctx, PROJ_ERR_COORD_TRANSFM_OUTSIDE_GRID);
         return HUGE_VAL;
@@ -3677,13 +4554,14 @@ static double read_vgrid_value(PJ_CONTEXT *ctx, const ListOfVGrids &grids,
     float value_b = 0;
     float value_c = 0;
     float value_d = 0;
-    bool error = (!grid->valueAt(grid_ix, grid_iy, value_a) ||
-                  !grid->valueAt(grid_ix2, grid_iy, value_b) ||
-                  !grid->valueAt(grid_ix, grid_iy2, value_c) ||
-                  !grid->valueAt(grid_ix2, grid_iy2, value_d));
+    bool error = (!nodes.valueAt(grid, grid_ix, grid_iy, value_a) ||
+                  !nodes.valueAt(grid, grid_ix2, grid_iy, value_b) ||
+                  !nodes.valueAt(grid, grid_ix, grid_iy2, value_c) ||
+                  !nodes.valueAt(grid, grid_ix2, grid_iy2, value_d));
     if (grid->hasChanged()) {
+        nodes.invalidate();
         if (curGridset->reopen(ctx)) {
-            return read_vgrid_value(ctx, grids, input, vmultiplier);
+            return read_vgrid_value(ctx, grids, input, vmultiplier, nodes);
         }
         error = true;
     }
@@ -3750,6 +4628,14 @@ static double read_vgrid_value(PJ_CONTEXT *ctx, const ListOfVGrids &grids,
     return value * vmultiplier;
 }
 
+// ---------------------------------------------------------------------------
+
+static double read_vgrid_value(PJ_CONTEXT *ctx, const ListOfVGrids &grids,
+                               const PJ_LP &input, const double vmultiplier) {
+    VGridNodeReader nodes;
+    return read_vgrid_value(ctx, grids, input, vmultiplier, nodes);
+}
+
 /**********************************************/
 ListOfVGrids pj_vgrid_init(PJ *P, const char *gridkey) {
     /**********************************************
@@ -3825,6 +4711,80 @@ double pj_vgrid_value(PJ *P, const ListOfVGrids &grids, PJ_LP lp,
 
 // ---------------------------------------------------------------------------
 
+/** Batched version of pj_vgrid_value(), adding (PJ_FWD) or subtracting
+ * (PJ_INV) the grid value to the z component of the n points of coo, and
+ * skipping the ones whose first component is HUGE_VAL. Points that cannot be
+ * transformed are set to HUGE_VAL, and the error code is stored in errors.
+ *
+ * As in pj_hgrid_apply_batch(), the values of the nodes around consecutive
+ * points that fall in the same grid are fetched at once.
+ */
+void pj_vgrid_apply_batch(PJ *P, const ListOfVGrids &grids, PJ_COORD *coo,
+                          size_t n, int *errors, double vmultiplier,
+                          PJ_DIRECTION direction) {
+    PJ_CONTEXT *ctx = P->ctx;
+    VGridNodeWindow window;
+    size_t i = 0;
+    while (i < n) {
+        if (coo[i].v[0] == HUGE_VAL) {
+            ++i;
+            continue;
+        }
+
+        /* Gather the run of points that fall in the grid of the first one */
+        window.invalidate();
+        VerticalShiftGridSet *gridset = nullptr;
+        const auto grid = findVGrid(grids, coo[i].lp, gridset);
+        size_t end = i + 1;
+        if (grid && !grid->isNullGrid() && grid->extentAndRes().isGeographic) {
+            const auto &extent = grid->extentAndRes();
+            GridCellBox box;
+            for (end = i; end < n; ++end) {
+                const PJ_LP lp = coo[end].lp;
+                if (lp.lam == HUGE_VAL)
+                    continue;
+                VerticalShiftGridSet *otherGridset = nullptr;
+                if (end > i && findVGrid(grids, lp, otherGridset) != grid)
+                    break;
+                box.add(grid, (lp.lam - extent.west) * extent.invResX,
+                        (lp.phi - extent.south) * extent.invResY);
+            }
+
+            int xStart = 0, yStart = 0, xCount = 0, yCount = 0;
+            if (box.getWindow(grid, 0, xStart, yStart, xCount, yCount))
+                window.fetch(grid, xStart, yStart, xCount, yCount);
+        }
+
+        for (size_t k = i; k < end; ++k) {
+            PJ_COORD &point = coo[k];
+            if (point.v[0] == HUGE_VAL)
+                continue;
+            ctx->last_errno = 0;
+
+            const double value =
+                read_vgrid_value(ctx, grids, point.lp, vmultiplier, window);
+            if (pj_log_active(ctx, PJ_LOG_TRACE)) {
+                proj_log_trace(P, "proj_vgrid_value: (%f, %f) = %f",
+                               point.lp.lam * RAD_TO_DEG,
+                               point.lp.phi * RAD_TO_DEG, value);
+            }
+
+            if (direction == PJ_FWD)
+                point.xyz.z += value;
+            else
+                point.xyz.z -= value;
+            if (ctx->last_errno) {
+                errors[k] = ctx->last_errno;
+                point = proj_coord_error();
+            }
+        }
+        i = end;
+    }
+    ctx->last_errno = 0;
+}
+
+// ---------------------------------------------------------------------------
+
 const GenericShiftGrid *pj_find_generic_grid(const ListOfGenericGrids &grids,
                                              const PJ_LP &input,
                                              GenericShiftGridSet *&gridSetOut) {
@@ -3922,6 +4882,130 @@ bool pj_bilinear_interpolation_three_samples(
     return true;
 }
 
+// ---------------------------------------------------------------------------
+
+// Background thread loading in the caches the grid blocks needed for areas
+// of interest. Tasks are processed one at a time, each with its own context.
+class GridPrefetcher {
+    struct Task {
+        PJ_CONTEXT *ctx;
+        std::vector<std::string> gridNames;
+        std::vector<ExtentAndRes> areas;
+    };
+
+    std::mutex m_mutex{};
+    std::mutex m_stopMutex{};
+    std::condition_variable m_cv{};
+    std::list<Task> m_tasks{};
+    std::thread m_thread{};
+    bool m_stop = false;
+
+    void run();
+
+    static void prefetchGrid(PJ_CONTEXT *ctx, const std::string &gridName,
+                             const std::vector<ExtentAndRes> &areas);
+
+  public:
+    GridPrefetcher() = default;
+    ~GridPrefetcher() { stop(); }
+
+    GridPrefetcher(const GridPrefetcher &) = delete;
+    GridPrefetcher &operator=(const GridPrefetcher &) = delete;
+
+    // Takes ownership of ctx
+    void enqueue(PJ_CONTEXT *ctx, std::vector<std::string> &&gridNames,
+                 std::vector<ExtentAndRes> &&areas);
+
+    // Discards pending tasks and waits for the current one to finish.
+    void stop();
+};
+
+// ---------------------------------------------------------------------------
+
+void GridPrefetcher::enqueue(PJ_CONTEXT *ctx,
+                             std::vector<std::string> &&gridNames,
+                             std::vector<ExtentAndRes> &&areas) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(Task{ctx, std::move(gridNames), std::move(areas)});
+    if (!m_thread.joinable())
+        m_thread = std::thread(&GridPrefetcher::run, this);
+    m_cv.notify_one();
+}
+
+// ---------------------------------------------------------------------------
+
+void GridPrefetcher::stop() {
+    std::lock_guard<std::mutex> stopLock(m_stopMutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_thread.joinable()) {
+        m_stop = true;
+        m_cv.notify_one();
+        lock.unlock();
+        m_thread.join();
+        lock.lock();
+        m_stop = false;
+    }
+    for (auto &task : m_tasks)
+        proj_context_destroy(task.ctx);
+    m_tasks.clear();
+}
+
+// ---------------------------------------------------------------------------
+
+void GridPrefetcher::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_cv.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+        if (m_stop)
+            return;
+        Task task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        lock.unlock();
+        for (const auto &gridName : task.gridNames)
+            prefetchGrid(task.ctx, gridName, task.areas);
+        proj_context_destroy(task.ctx);
+        lock.lock();
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+void GridPrefetcher::prefetchGrid(PJ_CONTEXT *ctx, const std::string &gridName,
+                                  const std::vector<ExtentAndRes> &areas) {
+#ifdef TIFF_ENABLED
+    // Only GeoTIFF grids are read by blocks. Other formats are small enough
+    // to be read on demand.
+    auto fp = FileManager::open_resource_file(ctx, gridName.c_str());
+    if (!fp)
+        return;
+    unsigned char header[4];
+    const size_t header_size = fp->read(header, sizeof(header));
+    if (!IsTIFF(header_size, header))
+        return;
+    fp->seek(0);
+    const std::string actualName(fp->name());
+    GTiffDataset dataset(ctx, std::move(fp));
+    if (!dataset.openTIFF(actualName))
+        return;
+    while (const auto grid = dataset.nextGrid()) {
+        for (const auto &area : areas)
+            grid->prefetch(area);
+    }
+#else
+    (void)ctx;
+    (void)gridName;
+    (void)areas;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+
+static GridPrefetcher gGridPrefetcher{};
+
+// ---------------------------------------------------------------------------
+
+void pj_stop_grid_prefetch() { gGridPrefetcher.stop(); }
+
 NS_PROJ_END
 
 /*****************************************************************************/
@@ -3999,6 +5083,89 @@ PJ_GRID_INFO proj_grid_info(const char *gridname) {
     return grinfo;
 }
 
+/*****************************************************************************/
+int proj_prefetch_grids_for_extent(PJ_CONTEXT *ctx, const PJ *P,
+                                   double west_lon_degree,
+                                   double south_lat_degree,
+                                   double east_lon_degree,
+                                   double north_lat_degree) {
+    /******************************************************************************
+        Start loading, in a background thread, the parts of the grids used by
+        P that are needed to transform coordinates in the specified area.
+
+        Returns TRUE if there were grids to prefetch, FALSE otherwise.
+    ******************************************************************************/
+    if (ctx == nullptr)
+        ctx = pj_get_default_ctx();
+    if (P == nullptr || !(south_lat_degree <= north_lat_degree)) {
+        proj_context_errno_set(ctx, PROJ_ERR_OTHER_API_MISUSE);
+        pj_log(ctx, PJ_LOG_ERROR, "%s: invalid input", __FUNCTION__);
+        return FALSE;
+    }
+
+    std::vector<std::string> gridNames;
+    const auto addGridsUsedBy = [ctx, &gridNames](const PJ *op) {
+        if (!op->iso_obj)
+            return;
+        const int count = proj_coordoperation_get_grid_used_count(ctx, op);
+        for (int i = 0; i < count; ++i) {
+            const char *shortName = nullptr;
+            int available = FALSE;
+            if (proj_coordoperation_get_grid_used(
+                    ctx, op, i, &shortName, nullptr, nullptr, nullptr, nullptr,
+                    nullptr, &available) &&
+                available && shortName[0] != '\0' &&
+                std::find(gridNames.begin(), gridNames.end(), shortName) ==
+                    gridNames.end()) {
+                gridNames.emplace_back(shortName);
+            }
+        }
+    };
+    if (P->alternativeCoordinateOperations.empty()) {
+        addGridsUsedBy(P);
+    } else {
+        for (const auto &alt : P->alternativeCoordinateOperations)
+            addGridsUsedBy(alt.pj);
+    }
+    if (gridNames.empty())
+        return FALSE;
+
+    const auto makeArea = [south_lat_degree, north_lat_degree](double west,
+                                                               double east) {
+        NS_PROJ::ExtentAndRes area;
+        area.isGeographic = true;
+        area.west = west * DEG_TO_RAD;
+        area.south = south_lat_degree * DEG_TO_RAD;
+        area.east = east * DEG_TO_RAD;
+        area.north = north_lat_degree * DEG_TO_RAD;
+        area.resX = 0;
+        area.resY = 0;
+        area.invResX = 0;
+        area.invResY = 0;
+        return area;
+    };
+    std::vector<NS_PROJ::ExtentAndRes> areas;
+    if (west_lon_degree <= east_lon_degree) {
+        areas.push_back(makeArea(west_lon_degree, east_lon_degree));
+    } else {
+        // Area crossing the antimeridian
+        areas.push_back(makeArea(west_lon_degree, 180));
+        areas.push_back(makeArea(-180, east_lon_degree));
+    }
+
+    auto prefetchCtx = proj_context_clone(ctx);
+    if (prefetchCtx == nullptr) {
+        proj_context_errno_set(ctx, PROJ_ERR_OTHER);
+        return FALSE;
+    }
+    // Errors are not relevant for a prefetch, and would be emitted from
+    // another thread.
+    proj_log_level(prefetchCtx, PJ_LOG_NONE);
+    NS_PROJ::gGridPrefetcher.enqueue(prefetchCtx, std::move(gridNames),
+                                     std::move(areas));
+    return TRUE;
+}
+
 /*****************************************************************************/
 PJ_INIT_INFO proj_init_info(const char *initname) {
     /******************************************************************************
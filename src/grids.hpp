@@ -85,6 +85,19 @@ class PROJ_GCC_DLL Grid {
 
 // ---------------------------------------------------------------------------
 
+/** Last grid returned by the gridAt() method of a grid set, with a box around
+ * it inside which the search of the grid set would lead to that grid again.
+ * This avoids walking the grid hierarchy for spatially coherent input. */
+struct GridAtCache {
+    const Grid *grid = nullptr;
+    double west = 0;
+    double south = 0;
+    double east = 0;
+    double north = 0;
+};
+
+// ---------------------------------------------------------------------------
+
 class PROJ_GCC_DLL VerticalShiftGrid : public Grid {
   protected:
     std::vector<std::unique_ptr<VerticalShiftGrid>> m_children{};
@@ -97,12 +110,22 @@ class PROJ_GCC_DLL VerticalShiftGrid : public Grid {
     PROJ_FOR_TEST const VerticalShiftGrid *gridAt(double longitude,
                                                   double lat) const;
 
+    PROJ_FOR_TEST const std::vector<std::unique_ptr<VerticalShiftGrid>> &
+    children() const {
+        return m_children;
+    }
+
     PROJ_FOR_TEST virtual bool isNodata(float /*val*/,
                                         double /* multiplier */) const = 0;
 
     // x = 0 is western-most column, y = 0 is southern-most line
     PROJ_FOR_TEST virtual bool valueAt(int x, int y, float &out) const = 0;
 
+    // Values of the x_count * y_count nodes starting at (x_start, y_start),
+    // stored row after row from the southern-most one.
+    PROJ_FOR_TEST virtual bool valuesAt(int x_start, int y_start, int x_count,
+                                        int y_count, float *out) const;
+
     PROJ_FOR_TEST virtual void reassign_context(PJ_CONTEXT *ctx) = 0;
 };
 
@@ -113,6 +136,7 @@ class PROJ_GCC_DLL VerticalShiftGridSet {
     std::string m_name{};
     std::string m_format{};
     std::vector<std::unique_ptr<VerticalShiftGrid>> m_grids{};
+    mutable GridAtCache m_lastGridAt{};
 
     VerticalShiftGridSet();
 
@@ -150,12 +174,25 @@ class PROJ_GCC_DLL HorizontalShiftGrid : public Grid {
     PROJ_FOR_TEST const HorizontalShiftGrid *gridAt(double longitude,
                                                     double lat) const;
 
+    PROJ_FOR_TEST const std::vector<std::unique_ptr<HorizontalShiftGrid>> &
+    children() const {
+        return m_children;
+    }
+
     // x = 0 is western-most column, y = 0 is southern-most line
     PROJ_FOR_TEST virtual bool valueAt(int x, int y,
                                        bool compensateNTConvention,
                                        float &longShift,
                                        float &latShift) const = 0;
 
+    // Shifts of the x_count * y_count nodes starting at (x_start, y_start),
+    // stored row after row from the southern-most one.
+    PROJ_FOR_TEST virtual bool valuesAt(int x_start, int y_start, int x_count,
+                                        int y_count,
+                                        bool compensateNTConvention,
+                                        float *longShift,
+                                        float *latShift) const;
+
     PROJ_FOR_TEST virtual void reassign_context(PJ_CONTEXT *ctx) = 0;
 };
 
@@ -166,6 +203,7 @@ class PROJ_GCC_DLL HorizontalShiftGridSet {
     std::string m_name{};
     std::string m_format{};
     std::vector<std::unique_ptr<HorizontalShiftGrid>> m_grids{};
+    mutable GridAtCache m_lastGridAt{};
 
     HorizontalShiftGridSet();
 
@@ -202,6 +240,11 @@ class PROJ_GCC_DLL GenericShiftGrid : public Grid {
 
     PROJ_FOR_TEST const GenericShiftGrid *gridAt(double x, double y) const;
 
+    PROJ_FOR_TEST const std::vector<std::unique_ptr<GenericShiftGrid>> &
+    children() const {
+        return m_children;
+    }
+
     virtual const std::string &type() const = 0;
 
     PROJ_FOR_TEST virtual std::string unit(int sample) const = 0;
@@ -229,6 +272,9 @@ class PROJ_GCC_DLL GenericShiftGridSet {
     std::string m_name{};
     std::string m_format{};
     std::vector<std::unique_ptr<GenericShiftGrid>> m_grids{};
+    mutable GridAtCache m_lastGridAt{};
+    mutable GridAtCache m_lastGridAtType{};
+    mutable std::string m_lastType{};
 
     GenericShiftGridSet();
 
@@ -267,6 +313,12 @@ double pj_vgrid_value(PJ *P, const ListOfVGrids &, PJ_LP lp,
                       double vmultiplier);
 PJ_LP pj_hgrid_apply(PJ_CONTEXT *ctx, const ListOfHGrids &grids, PJ_LP lp,
                      PJ_DIRECTION direction);
+void pj_hgrid_apply_batch(PJ_CONTEXT *ctx, const ListOfHGrids &grids,
+                          PJ_COORD *coo, size_t n, int *errors,
+                          PJ_DIRECTION direction);
+void pj_vgrid_apply_batch(PJ *P, const ListOfVGrids &grids, PJ_COORD *coo,
+                          size_t n, int *errors, double vmultiplier,
+                          PJ_DIRECTION direction);
 
 const GenericShiftGrid *pj_find_generic_grid(const ListOfGenericGrids &grids,
                                              const PJ_LP &input,
@@ -275,6 +327,9 @@ bool pj_bilinear_interpolation_three_samples(
     PJ_CONTEXT *ctx, const GenericShiftGrid *grid, const PJ_LP &lp, int idx1,
     int idx2, int idx3, double &v1, double &v2, double &v3, bool &must_retry);
 
+void pj_clear_grid_block_cache();
+void pj_stop_grid_prefetch();
+
 NS_PROJ_END
 
 #endif // GRIDS_HPP_INCLUDED
@@ -33,6 +33,9 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "filemanager.hpp"
 #include "geodesic.h"
 #include "proj.h"
@@ -422,15 +425,27 @@ paralist *pj_expand_init(PJ_CONTEXT *ctx, paralist *init) {
 /************************************************************************/
 
 static PJ_CONSTRUCTOR locate_constructor(const char *name) {
-    int i;
-    const char *s;
-    const PJ_OPERATIONS *operations;
-    operations = proj_list_operations();
-    for (i = 0; (s = operations[i].id) && strcmp(name, s); ++i)
-        ;
-    if (nullptr == s)
+    /* Operations sorted by id, so that they can be binary searched. Built */
+    /* once, in a thread-safe way, on first use */
+    static const std::vector<const PJ_OPERATIONS *> sortedOperations = []() {
+        std::vector<const PJ_OPERATIONS *> res;
+        for (const PJ_OPERATIONS *op = proj_list_operations(); op->id; ++op)
+            res.push_back(op);
+        std::stable_sort(res.begin(), res.end(),
+                         [](const PJ_OPERATIONS *a, const PJ_OPERATIONS *b) {
+                             return strcmp(a->id, b->id) < 0;
+                         });
+        return res;
+    }();
+
+    const auto iter = std::lower_bound(
+        sortedOperations.begin(), sortedOperations.end(), name,
+        [](const PJ_OPERATIONS *op, const char *key) {
+            return strcmp(op->id, key) < 0;
+        });
+    if (iter == sortedOperations.end() || strcmp((*iter)->id, name) != 0)
         return nullptr;
-    return (PJ_CONSTRUCTOR)operations[i].proj;
+    return (PJ_CONSTRUCTOR)(*iter)->proj;
 }
 
 PJ *pj_init_ctx_with_allow_init_epsg(PJ_CONTEXT *ctx, int argc, char **argv,
@@ -53,6 +53,7 @@ paralist *pj_clone_paralist(const paralist *list) {
         newitem->used = 0;
         newitem->next = nullptr;
         strcpy(newitem->param, list->param);
+        newitem->key_len = list->key_len;
 
         if (next_copy)
             next_copy->next = newitem;
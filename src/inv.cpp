@@ -262,3 +262,56 @@ bool pj_inv4d(PJ_COORD &coo, PJ *P) {
     P->ctx->last_errno = last_errno;
     return true;
 }
+
+void pj_inv4d_batch(PJ_COORD *coo, size_t n, int *errors, PJ *P) {
+
+    const int last_errno = P->ctx->last_errno;
+
+    /* No batched converter available: go point by point */
+    if (P->inv4d_batch == nullptr ||
+        (P->inv4d == nullptr && P->inv3d == nullptr && P->inv == nullptr)) {
+        for (size_t i = 0; i < n; i++) {
+            if (HUGE_VAL == coo[i].v[0])
+                continue;
+            P->ctx->last_errno = 0;
+            if (!pj_inv4d(coo[i], P) && P->ctx->last_errno)
+                errors[i] = P->ctx->last_errno;
+        }
+        P->ctx->last_errno = last_errno;
+        return;
+    }
+
+    if (!P->skip_inv_prepare) {
+        for (size_t i = 0; i < n; i++) {
+            if (HUGE_VAL == coo[i].v[0])
+                continue;
+            P->ctx->last_errno = 0;
+            inv_prepare(P, coo[i]);
+            if (HUGE_VAL == coo[i].v[0] || P->ctx->last_errno) {
+                coo[i] = proj_coord_error();
+                if (P->ctx->last_errno)
+                    errors[i] = P->ctx->last_errno;
+            }
+        }
+    }
+
+    P->ctx->last_errno = 0;
+    P->inv4d_batch(coo, n, errors, P);
+
+    for (size_t i = 0; i < n; i++) {
+        if (HUGE_VAL == coo[i].v[0]) {
+            coo[i] = proj_coord_error();
+            continue;
+        }
+        if (!P->skip_inv_finalize) {
+            P->ctx->last_errno = 0;
+            inv_finalize(P, coo[i]);
+            if (P->ctx->last_errno) {
+                errors[i] = P->ctx->last_errno;
+                coo[i] = proj_coord_error();
+            }
+        }
+    }
+
+    P->ctx->last_errno = last_errno;
+}
@@ -191,6 +191,24 @@ getDBcontextNoException(PJ_CONTEXT *ctx, const char *function) {
 }
 // ---------------------------------------------------------------------------
 
+/** Instantiate the PJ of a coordinate operation from its PROJ string */
+static PJ *
+pj_create_for_iso_obj(PJ_CONTEXT *ctx,
+                      const std::shared_ptr<const std::string> &projString) {
+    const bool defer_grid_opening_backup = ctx->defer_grid_opening;
+    if (!defer_grid_opening_backup && proj_context_is_network_enabled(ctx)) {
+        ctx->defer_grid_opening = true;
+    }
+    auto pj = pj_create_internal(ctx, projString->c_str());
+    ctx->defer_grid_opening = defer_grid_opening_backup;
+    if (pj) {
+        pj->iso_obj_proj_string = projString;
+    }
+    return pj;
+}
+
+// ---------------------------------------------------------------------------
+
 PJ *pj_obj_create(PJ_CONTEXT *ctx, const BaseObjectNNPtr &objIn) {
     auto coordop = dynamic_cast<const CoordinateOperation *>(objIn.get());
     if (coordop) {
@@ -219,14 +237,9 @@ PJ *pj_obj_create(PJ_CONTEXT *ctx, const BaseObjectNNPtr &objIn) {
                 auto formatter = PROJStringFormatter::create(
                     PROJStringFormatter::Convention::PROJ_5,
                     std::move(dbContext));
-                auto projString = coordop->exportToPROJString(formatter.get());
-                const bool defer_grid_opening_backup = ctx->defer_grid_opening;
-                if (!defer_grid_opening_backup &&
-                    proj_context_is_network_enabled(ctx)) {
-                    ctx->defer_grid_opening = true;
-                }
-                auto pj = pj_create_internal(ctx, projString.c_str());
-                ctx->defer_grid_opening = defer_grid_opening_backup;
+                auto projString = std::make_shared<const std::string>(
+                    coordop->exportToPROJString(formatter.get()));
+                auto pj = pj_create_for_iso_obj(ctx, projString);
                 if (pj) {
                     pj->iso_obj = objIn;
                     pj->iso_obj_is_coordinate_operation = true;
@@ -583,7 +596,27 @@ PJ *proj_clone(PJ_CONTEXT *ctx, const PJ *obj) {
     }
     try {
         ctx->forceOver = obj->over != 0;
-        PJ *newPj = pj_obj_create(ctx, NN_NO_CHECK(obj->iso_obj));
+        PJ *newPj;
+        if (obj->iso_obj_proj_string) {
+            // Re-use the PROJ string of obj rather than exporting its
+            // ISO-19111 object again.
+            newPj = pj_create_for_iso_obj(ctx, obj->iso_obj_proj_string);
+            if (newPj) {
+                newPj->iso_obj = obj->iso_obj;
+                newPj->iso_obj_is_coordinate_operation =
+                    obj->iso_obj_is_coordinate_operation;
+                newPj->hasCoordinateEpoch = obj->hasCoordinateEpoch;
+                newPj->coordinateEpoch = obj->coordinateEpoch;
+                if (obj->gridsNeededAsked) {
+                    newPj->gridsNeededAsked = true;
+                    for (const auto &gridDesc : obj->gridsNeeded) {
+                        newPj->gridsNeeded.emplace_back(gridDesc);
+                    }
+                }
+            }
+        } else {
+            newPj = pj_obj_create(ctx, NN_NO_CHECK(obj->iso_obj));
+        }
         ctx->forceOver = false;
         if (newPj) {
             newPj->copyStateFrom(*obj);
@@ -3028,13 +3061,6 @@ proj_get_crs_info_list_from_database(PJ_CONTEXT *ctx, const char *auth_name,
             dbContext->getVersionedAuthoritiesFromName(authName);
         if (actualAuthNames.empty())
             actualAuthNames.push_back(std::move(authName));
-        std::list<AuthorityFactory::CRSInfo> concatList;
-        for (const auto &actualAuthName : actualAuthNames) {
-            auto factory = AuthorityFactory::create(dbContext, actualAuthName);
-            auto list = factory->getCRSInfoList();
-            concatList.splice(concatList.end(), std::move(list));
-        }
-        ret = new PROJ_CRS_INFO *[concatList.size() + 1];
         GeographicBoundingBoxPtr bbox;
         if (params && params->bbox_valid) {
             bbox = GeographicBoundingBox::create(
@@ -3042,6 +3068,13 @@ proj_get_crs_info_list_from_database(PJ_CONTEXT *ctx, const char *auth_name,
                        params->east_lon_degree, params->north_lat_degree)
                        .as_nullable();
         }
+        std::list<AuthorityFactory::CRSInfo> concatList;
+        for (const auto &actualAuthName : actualAuthNames) {
+            auto factory = AuthorityFactory::create(dbContext, actualAuthName);
+            auto list = factory->getCRSInfoList(bbox);
+            concatList.splice(concatList.end(), std::move(list));
+        }
+        ret = new PROJ_CRS_INFO *[concatList.size() + 1];
         for (const auto &info : concatList) {
             auto type = PJ_TYPE_CRS;
             if (info.type == AuthorityFactory::ObjectType::GEOGRAPHIC_2D_CRS) {
@@ -53,6 +53,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
@@ -163,8 +164,107 @@ struct SQLValues {
 
 // ---------------------------------------------------------------------------
 
-using SQLRow = std::vector<std::string>;
-using SQLResultSet = std::list<SQLRow>;
+// Row of a SQL result set. The text of all columns is stored in a single
+// buffer, and numeric columns also keep their native value, so that building
+// a row does not require an allocation per column, and numeric values do not
+// need to be parsed back from their text representation.
+class SQLRow {
+  public:
+    SQLRow() = default;
+
+    // cppcheck-suppress noExplicitConstructor
+    SQLRow(std::initializer_list<std::string> values) {
+        fields_.reserve(values.size());
+        for (const auto &value : values) {
+            addField(SQLITE_TEXT, value.data(), value.size());
+        }
+    }
+
+    SQLRow(sqlite3_stmt *stmt, int column_count, bool useMaxFloatPrecision);
+
+    size_t size() const { return fields_.size(); }
+
+    // Return the text value of a column (empty string for NULL)
+    std::string operator[](size_t i) const {
+        const auto &field = fields_[i];
+        return std::string(text_.data() + field.offset, field.size);
+    }
+
+    bool isNull(size_t i) const { return fields_[i].type == SQLITE_NULL; }
+
+    // Return the value of a numeric column, or of a text column parsed with
+    // c_locale_stod(). Throws std::invalid_argument if there is no value.
+    double getDouble(size_t i) const {
+        const auto &field = fields_[i];
+        if (field.type == SQLITE_FLOAT || field.type == SQLITE_INTEGER)
+            return field.value;
+        return c_locale_stod((*this)[i]);
+    }
+
+    // Return whether the text value of a column is equal to str
+    bool equals(size_t i, const char *str) const {
+        const auto &field = fields_[i];
+        return strlen(str) == field.size &&
+               memcmp(text_.data() + field.offset, str, field.size) == 0;
+    }
+
+  private:
+    struct Field {
+        int type;
+        size_t offset;
+        size_t size;
+        double value;
+    };
+    std::string text_{};
+    std::vector<Field> fields_{};
+
+    void addField(int type, const char *txt, size_t size, double value = 0) {
+        fields_.push_back(Field{type, text_.size(), size, value});
+        text_.append(txt, size);
+    }
+};
+
+// ---------------------------------------------------------------------------
+
+SQLRow::SQLRow(sqlite3_stmt *stmt, int column_count,
+               bool useMaxFloatPrecision) {
+    // First pass to size the text buffer. This converts all values to text,
+    // whose pointers stay valid until the next step of the statement.
+    size_t textSize = 0;
+    for (int i = 0; i < column_count; i++) {
+        if (sqlite3_column_text(stmt, i))
+            textSize += static_cast<size_t>(sqlite3_column_bytes(stmt, i));
+    }
+    text_.reserve(textSize);
+    fields_.reserve(static_cast<size_t>(column_count));
+
+    for (int i = 0; i < column_count; i++) {
+        const int type = sqlite3_column_type(stmt, i);
+        const double value = (type == SQLITE_FLOAT || type == SQLITE_INTEGER)
+                                 ? sqlite3_column_double(stmt, i)
+                                 : 0.0;
+        if (useMaxFloatPrecision && type == SQLITE_FLOAT) {
+            // sqlite3_column_text() does not use maximum precision
+            std::ostringstream buffer;
+            buffer.imbue(std::locale::classic());
+            buffer << std::setprecision(18);
+            buffer << value;
+            const auto str = buffer.str();
+            addField(type, str.data(), str.size(), value);
+        } else {
+            const char *txt =
+                reinterpret_cast<const char *>(sqlite3_column_text(stmt, i));
+            addField(type, txt ? txt : "",
+                     txt ? static_cast<size_t>(sqlite3_column_bytes(stmt, i))
+                         : 0,
+                     value);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+using SQLResultSet = std::vector<SQLRow>;
 using ListOfParams = std::list<SQLValues>;
 
 // ---------------------------------------------------------------------------
@@ -236,6 +336,33 @@ static void PROJ_SQLITE_intersects_bbox(sqlite3_context *pContext,
 
 // ---------------------------------------------------------------------------
 
+// Return a SQL condition selecting the boxes of the extent_rtree table,
+// aliased as r, that may intersect bbox. As extents crossing the antimeridian
+// are split in extent_rtree, so is bbox. This is only a pre-filter to be
+// completed by an exact test, as R*Tree boxes are rounded outwards.
+static std::string
+getSqlExtentRTreeIntersects(const metadata::GeographicBoundingBox &bbox,
+                            ListOfParams &params) {
+    const double west_lon = bbox.westBoundLongitude();
+    const double east_lon = bbox.eastBoundLongitude();
+    std::string sql;
+    if (west_lon <= east_lon) {
+        sql = "r.west_lon <= ? AND r.east_lon >= ? ";
+        params.emplace_back(east_lon);
+        params.emplace_back(west_lon);
+    } else {
+        sql = "(r.east_lon >= ? OR r.west_lon <= ?) ";
+        params.emplace_back(west_lon);
+        params.emplace_back(east_lon);
+    }
+    sql += "AND r.south_lat <= ? AND r.north_lat >= ? ";
+    params.emplace_back(bbox.northBoundLatitude());
+    params.emplace_back(bbox.southBoundLatitude());
+    return sql;
+}
+
+// ---------------------------------------------------------------------------
+
 class SQLiteHandle {
     std::string path_{};
     sqlite3 *sqlite_handle_ = nullptr;
@@ -462,25 +589,7 @@ SQLResultSet SQLiteHandle::run(sqlite3_stmt *stmt, const std::string &sql,
     while (true) {
         int ret = sqlite3_step(stmt);
         if (ret == SQLITE_ROW) {
-            SQLRow row(column_count);
-            for (int i = 0; i < column_count; i++) {
-                if (useMaxFloatPrecision &&
-                    sqlite3_column_type(stmt, i) == SQLITE_FLOAT) {
-                    // sqlite3_column_text() does not use maximum precision
-                    std::ostringstream buffer;
-                    buffer.imbue(std::locale::classic());
-                    buffer << std::setprecision(18);
-                    buffer << sqlite3_column_double(stmt, i);
-                    row[i] = buffer.str();
-                } else {
-                    const char *txt = reinterpret_cast<const char *>(
-                        sqlite3_column_text(stmt, i));
-                    if (txt) {
-                        row[i] = txt;
-                    }
-                }
-            }
-            result.emplace_back(std::move(row));
+            result.emplace_back(stmt, column_count, useMaxFloatPrecision);
         } else if (ret == SQLITE_DONE) {
             break;
         } else {
@@ -549,9 +658,9 @@ void SQLiteHandle::checkDatabaseLayout(const std::string &mainDbPath,
     int major = 0;
     int minor = 0;
     for (const auto &row : res) {
-        if (row[0] == "DATABASE.LAYOUT.VERSION.MAJOR") {
+        if (row.equals(0, "DATABASE.LAYOUT.VERSION.MAJOR")) {
             major = atoi(row[1].c_str());
-        } else if (row[0] == "DATABASE.LAYOUT.VERSION.MINOR") {
+        } else if (row.equals(0, "DATABASE.LAYOUT.VERSION.MINOR")) {
             minor = atoi(row[1].c_str());
         }
     }
@@ -723,6 +832,10 @@ struct DatabaseContext::Private {
 
     std::vector<std::string> getDatabaseStructure();
 
+    bool canUseExtentRTree(const metadata::GeographicBoundingBox &bbox);
+
+    bool canUseProjectedCRSFingerprint();
+
     // cppcheck-suppress functionStatic
     const std::string &getPath() const { return databasePath_; }
 
@@ -753,6 +866,23 @@ struct DatabaseContext::Private {
         return mapCanonicalizeGRFName_;
     }
 
+    // Name or alias of an object, with its canonicalized form, used for
+    // approximate searches by name
+    struct ObjectName {
+        std::string authName{};
+        std::string code{};
+        bool codeIsInteger = false;
+        std::string name{};
+        std::string canonicalizedName{};
+        std::string type{};
+        bool deprecated = false;
+        bool isAlias = false;
+        bool hasFrameReferenceEpoch = false;
+        bool isEnsemble = false;
+    };
+    const std::vector<ObjectName> &
+    getCacheObjectNames(const std::string &tableName);
+
     // cppcheck-suppress functionStatic
     common::UnitOfMeasurePtr getUOMFromCache(const std::string &code);
     // cppcheck-suppress functionStatic
@@ -848,6 +978,8 @@ struct DatabaseContext::Private {
     PJ_CONTEXT *pjCtxt_ = nullptr;
     int recLevel_ = 0;
     bool detach_ = false;
+    int hasExtentRTree_ = -1;
+    int hasProjectedCRSFingerprint_ = -1;
     std::string lastMetadataValue_{};
     std::map<std::string, std::list<SQLRow>> mapCanonicalizeGRFName_{};
 
@@ -878,6 +1010,8 @@ struct DatabaseContext::Private {
 
     std::vector<VersionedAuthName> cacheAuthNameWithVersion_{};
 
+    std::map<std::string, std::vector<ObjectName>> cacheObjectNames_{};
+
     static void insertIntoCache(LRUCacheOfObjects &cache,
                                 const std::string &code,
                                 const util::BaseObjectPtr &obj);
@@ -1015,6 +1149,8 @@ void DatabaseContext::Private::closeDB() noexcept {
         }
         detach_ = false;
     }
+    hasExtentRTree_ = -1;
+    hasProjectedCRSFingerprint_ = -1;
 
     for (auto &pair : mapSqlToStatement_) {
         sqlite3_finalize(pair.second);
@@ -1288,7 +1424,11 @@ std::vector<std::string> DatabaseContext::Private::getDatabaseStructure() {
                                        : "db_0.");
     const auto sqlBegin("SELECT sql||';' FROM " + dbNamePrefix +
                         "sqlite_master WHERE type = ");
-    const char *tableType = "'table' AND name NOT LIKE 'sqlite_stat%'";
+    // The extent_rtree and projected_crs_fingerprint tables are indices
+    // derived from other tables
+    const char *tableType = "'table' AND name NOT LIKE 'sqlite_stat%' "
+                            "AND name NOT LIKE 'extent_rtree%' "
+                            "AND name != 'projected_crs_fingerprint'";
     const char *const objectTypes[] = {tableType, "'view'", "'trigger'"};
     std::vector<std::string> res;
     for (const auto &objectType : objectTypes) {
@@ -1310,15 +1450,67 @@ std::vector<std::string> DatabaseContext::Private::getDatabaseStructure() {
 
 // ---------------------------------------------------------------------------
 
+// Whether the extent_rtree R*Tree index can be used to find the extents
+// intersecting bbox. It is absent from databases of older PROJ versions,
+// cannot be used if SQLite is built without the R*Tree module, and does not
+// index the extents of auxiliary databases.
+bool DatabaseContext::Private::canUseExtentRTree(
+    const metadata::GeographicBoundingBox &bbox) {
+    if (hasExtentRTree_ < 0) {
+        hasExtentRTree_ = 0;
+        if (!detach_) {
+            try {
+                run("SELECT 1 FROM extent_rtree LIMIT 0");
+                hasExtentRTree_ = 1;
+            } catch (const std::exception &) {
+            }
+        }
+    }
+    const double west_lon = bbox.westBoundLongitude();
+    const double south_lat = bbox.southBoundLatitude();
+    const double east_lon = bbox.eastBoundLongitude();
+    const double north_lat = bbox.northBoundLatitude();
+    return hasExtentRTree_ == 1 && west_lon >= -180.0 && west_lon <= 180.0 &&
+           east_lon >= -180.0 && east_lon <= 180.0 && south_lat >= -90.0 &&
+           south_lat <= north_lat && north_lat <= 90.0;
+}
+
+// ---------------------------------------------------------------------------
+
+// Whether the projected_crs_fingerprint table can be used to find the
+// candidates of ProjectedCRS::identify(). It is absent from databases of
+// older PROJ versions, and does not index the projected CRS of auxiliary
+// databases.
+bool DatabaseContext::Private::canUseProjectedCRSFingerprint() {
+    if (hasProjectedCRSFingerprint_ < 0) {
+        hasProjectedCRSFingerprint_ = 0;
+        if (!detach_) {
+            try {
+                run("SELECT 1 FROM projected_crs_fingerprint LIMIT 0");
+                hasProjectedCRSFingerprint_ = 1;
+            } catch (const std::exception &) {
+            }
+        }
+    }
+    return hasProjectedCRSFingerprint_ == 1;
+}
+
+// ---------------------------------------------------------------------------
+
 void DatabaseContext::Private::attachExtraDatabases(
     const std::vector<std::string> &auxiliaryDatabasePaths) {
 
     auto l_handle = handle();
     assert(l_handle);
 
+    // The extent_rtree and projected_crs_fingerprint tables only index the
+    // objects of the main database, so they are not usable once auxiliary
+    // databases are attached.
     auto tables = run("SELECT name, type, sql FROM sqlite_master WHERE type IN "
                       "('table', 'view') "
-                      "AND name NOT LIKE 'sqlite_stat%'");
+                      "AND name NOT LIKE 'sqlite_stat%' "
+                      "AND name NOT LIKE 'extent_rtree%' "
+                      "AND name != 'projected_crs_fingerprint'");
 
     struct TableStructure {
         std::string name{};
@@ -1345,6 +1537,7 @@ void DatabaseContext::Private::attachExtraDatabases(
     const int nLayoutVersionMajor = l_handle->getLayoutVersionMajor();
     const int nLayoutVersionMinor = l_handle->getLayoutVersionMinor();
 
+    cacheObjectNames_.clear();
     closeDB();
     if (auxiliaryDatabasePaths.empty()) {
         open(databasePath_, pjCtxt());
@@ -3370,7 +3563,7 @@ bool DatabaseContext::lookForGridAlternative(const std::string &officialName,
     const auto &row = res.front();
     projFilename = row[0];
     projFormat = row[1];
-    inverse = row[2] == "1";
+    inverse = row.equals(2, "1");
     return true;
 }
 
@@ -3912,6 +4105,57 @@ DatabaseContext::Private::getCacheAuthNameWithVersion() {
 
 // ---------------------------------------------------------------------------
 
+const std::vector<DatabaseContext::Private::ObjectName> &
+DatabaseContext::Private::getCacheObjectNames(const std::string &tableName) {
+    auto iter = cacheObjectNames_.find(tableName);
+    if (iter != cacheObjectNames_.end()) {
+        return iter->second;
+    }
+
+    const bool isGeodeticCRS = tableName == "geodetic_crs";
+    const bool isDatum =
+        tableName == "geodetic_datum" || tableName == "vertical_datum";
+    std::string columns("ov.auth_name, ov.code, typeof(ov.code) = 'integer', ");
+    columns += isGeodeticCRS ? "ov.type, " : "NULL, ";
+    columns += isDatum ? "ov.frame_reference_epoch IS NOT NULL, "
+                         "ov.ensemble_accuracy IS NOT NULL, "
+                       : "0, 0, ";
+    columns += "ov.deprecated, ";
+    std::string sql("SELECT ");
+    sql += columns;
+    sql += "ov.name, 0 FROM ";
+    sql += tableName;
+    sql += " ov UNION ALL SELECT ";
+    sql += columns;
+    sql += "a.alt_name, 1 FROM ";
+    sql += tableName;
+    sql += " ov JOIN alias_name a ON "
+           "ov.auth_name = a.auth_name AND ov.code = a.code WHERE "
+           "a.source != 'EPSG_OLD' AND a.table_name = ?";
+    const auto sqlRes = run(sql, {tableName});
+
+    auto &objectNames = cacheObjectNames_[tableName];
+    objectNames.reserve(sqlRes.size());
+    for (const auto &row : sqlRes) {
+        ObjectName objectName;
+        objectName.authName = row[0];
+        objectName.code = row[1];
+        objectName.codeIsInteger = row.equals(2, "1");
+        objectName.type = row[3];
+        objectName.hasFrameReferenceEpoch = row.equals(4, "1");
+        objectName.isEnsemble = row.equals(5, "1");
+        objectName.deprecated = row.equals(6, "1");
+        objectName.name = row[7];
+        objectName.canonicalizedName =
+            metadata::Identifier::canonicalizeName(objectName.name);
+        objectName.isAlias = row.equals(8, "1");
+        objectNames.emplace_back(std::move(objectName));
+    }
+    return objectNames;
+}
+
+// ---------------------------------------------------------------------------
+
 // From IAU_2015 returns (IAU,2015)
 bool DatabaseContext::getAuthorityAndVersion(
     const std::string &versionedAuthName, std::string &authNameOut,
@@ -4037,9 +4281,9 @@ bool DatabaseContext::toWGS84AutocorrectWrongValues(
     bool bFound9606 = false;
     bool bFound9607 = false;
     for (const auto &row : d->run(sql, params)) {
-        if (row[0] == "9606") {
+        if (row.equals(0, "9606")) {
             bFound9606 = true;
-        } else if (row[0] == "9607") {
+        } else if (row.equals(0, "9607")) {
             bFound9607 = true;
         }
     }
@@ -4141,6 +4385,13 @@ struct AuthorityFactory::Private {
 
     SQLResultSet runWithCodeParam(const char *sql, const std::string &code);
 
+    SQLResultSet findObjectsByApproximateName(
+        const std::list<std::pair<std::string, std::string>>
+            &listTableNameType,
+        const std::string &searchedName,
+        const std::string &canonicalizedSearchedName, bool deprecated,
+        bool useAliases);
+
     bool hasAuthorityRestriction() const {
         return !authority_.empty() && authority_ != "any";
     }
@@ -4185,6 +4436,112 @@ AuthorityFactory::Private::runWithCodeParam(const char *sql,
 
 // ---------------------------------------------------------------------------
 
+// Return the (table_name, auth_name, code, name, deprecated, is_alias) of the
+// objects of the (table_name, constraint) pairs of listTableNameType whose
+// name or alias contains searchedName, or whose canonicalized name contains
+// canonicalizedSearchedName. They are ordered as createObjectsFromNameEx()
+// does in SQL for exact searches.
+// The canonicalized names are cached by the database context, which avoids
+// canonicalizing all the names of the tables at each call.
+SQLResultSet AuthorityFactory::Private::findObjectsByApproximateName(
+    const std::list<std::pair<std::string, std::string>> &listTableNameType,
+    const std::string &searchedName,
+    const std::string &canonicalizedSearchedName, bool deprecated,
+    bool useAliases) {
+
+    using ObjectName = DatabaseContext::Private::ObjectName;
+    std::vector<std::pair<const std::string *, const ObjectName *>> matches;
+    for (const auto &tableNameTypePair : listTableNameType) {
+        const auto &tableName = tableNameTypePair.first;
+        const auto &constraint = tableNameTypePair.second;
+        for (const auto &objectName :
+             context()->getPrivate()->getCacheObjectNames(tableName)) {
+            if ((objectName.isAlias && !useAliases) ||
+                (deprecated && !objectName.deprecated) ||
+                (hasAuthorityRestriction() &&
+                 objectName.authName != authority())) {
+                continue;
+            }
+            if (!constraint.empty()) {
+                if (constraint == "frame_reference_epoch") {
+                    if (!objectName.hasFrameReferenceEpoch)
+                        continue;
+                } else if (constraint == "ensemble") {
+                    if (!objectName.isEnsemble)
+                        continue;
+                } else if (objectName.type != constraint) {
+                    continue;
+                }
+            }
+            if (ci_find(objectName.name, searchedName) == std::string::npos &&
+                objectName.canonicalizedName.find(canonicalizedSearchedName) ==
+                    std::string::npos) {
+                continue;
+            }
+            matches.emplace_back(&tableName, &objectName);
+        }
+    }
+
+    // Number of characters of a UTF-8 string, as SQLite length()
+    const auto utf8Length = [](const std::string &str) {
+        return std::count_if(str.begin(), str.end(), [](char ch) {
+            return (static_cast<unsigned char>(ch) & 0xC0) != 0x80;
+        });
+    };
+    // Same ordering as SQLite for codes that are integers or text
+    const auto codeLess = [](const ObjectName &a, const ObjectName &b) {
+        if (a.codeIsInteger != b.codeIsInteger) {
+            return a.codeIsInteger;
+        }
+        if (a.codeIsInteger) {
+            return std::stoll(a.code) < std::stoll(b.code);
+        }
+        return a.code < b.code;
+    };
+    std::stable_sort(
+        matches.begin(), matches.end(),
+        [&utf8Length, &codeLess](
+            const std::pair<const std::string *, const ObjectName *> &a,
+            const std::pair<const std::string *, const ObjectName *> &b) {
+            const auto &objA = *(a.second);
+            const auto &objB = *(b.second);
+            if (objA.deprecated != objB.deprecated) {
+                return objB.deprecated;
+            }
+            if (objA.isAlias != objB.isAlias) {
+                return objB.isAlias;
+            }
+            const auto lengthA = utf8Length(objA.name);
+            const auto lengthB = utf8Length(objB.name);
+            if (lengthA != lengthB) {
+                return lengthA < lengthB;
+            }
+            if (objA.name != objB.name) {
+                return objA.name < objB.name;
+            }
+            if (*(a.first) != *(b.first)) {
+                return *(a.first) < *(b.first);
+            }
+            if (objA.authName != objB.authName) {
+                return objA.authName < objB.authName;
+            }
+            return codeLess(objA, objB);
+        });
+
+    SQLResultSet res;
+    res.reserve(matches.size());
+    for (const auto &match : matches) {
+        const auto &objectName = *(match.second);
+        res.emplace_back(SQLRow{*(match.first), objectName.authName,
+                                objectName.code, objectName.name,
+                                objectName.deprecated ? "1" : "0",
+                                objectName.isAlias ? "1" : "0"});
+    }
+    return res;
+}
+
+// ---------------------------------------------------------------------------
+
 UnitOfMeasure
 AuthorityFactory::Private::createUnitOfMeasure(const std::string &auth_name,
                                                const std::string &code) {
@@ -4258,13 +4615,8 @@ util::PropertyMap AuthorityFactory::Private::createPropertiesSearchUsages(
     std::vector<ObjectDomainNNPtr> usages;
     for (const auto &row : res) {
         try {
-            size_t idx = 0;
-            const auto &extent_description = row[idx++];
-            const auto &south_lat_str = row[idx++];
-            const auto &north_lat_str = row[idx++];
-            const auto &west_lon_str = row[idx++];
-            const auto &east_lon_str = row[idx++];
-            const auto &scope = row[idx];
+            const auto &extent_description = row[0];
+            const auto &scope = row[5];
 
             util::optional<std::string> scopeOpt;
             if (!scope.empty()) {
@@ -4272,16 +4624,16 @@ util::PropertyMap AuthorityFactory::Private::createPropertiesSearchUsages(
             }
 
             metadata::ExtentPtr extent;
-            if (south_lat_str.empty()) {
+            if (row.isNull(1)) {
                 extent = metadata::Extent::create(
                              util::optional<std::string>(extent_description),
                              {}, {}, {})
                              .as_nullable();
             } else {
-                double south_lat = c_locale_stod(south_lat_str);
-                double north_lat = c_locale_stod(north_lat_str);
-                double west_lon = c_locale_stod(west_lon_str);
-                double east_lon = c_locale_stod(east_lon_str);
+                double south_lat = row.getDouble(1);
+                double north_lat = row.getDouble(2);
+                double west_lon = row.getDouble(3);
+                double east_lon = row.getDouble(4);
                 auto bbox = metadata::GeographicBoundingBox::create(
                     west_lon, south_lat, east_lon, north_lat);
                 extent = metadata::Extent::create(
@@ -4585,10 +4937,10 @@ AuthorityFactory::createExtent(const std::string &code) const {
             d->context()->d->cache(cacheKey, extent);
             return extent;
         }
-        double south_lat = c_locale_stod(row[1]);
-        double north_lat = c_locale_stod(row[2]);
-        double west_lon = c_locale_stod(row[3]);
-        double east_lon = c_locale_stod(row[4]);
+        double south_lat = row.getDouble(1);
+        double north_lat = row.getDouble(2);
+        double west_lon = row.getDouble(3);
+        double east_lon = row.getDouble(4);
         auto bbox = metadata::GeographicBoundingBox::create(
             west_lon, south_lat, east_lon, north_lat);
 
@@ -4635,12 +4987,12 @@ AuthorityFactory::createUnitOfMeasure(const std::string &code) const {
     try {
         const auto &row = res.front();
         const auto &name =
-            (row[0] == "degree (supplier to define representation)")
+            (row.equals(0, "degree (supplier to define representation)"))
                 ? UnitOfMeasure::DEGREE.name()
                 : row[0];
         double conv_factor = (code == "9107" || code == "9108")
                                  ? UnitOfMeasure::DEGREE.conversionToSI()
-                                 : c_locale_stod(row[1]);
+                                 : row.getDouble(1);
         constexpr double EPS = 1e-10;
         if (std::fabs(conv_factor - UnitOfMeasure::DEGREE.conversionToSI()) <
             EPS * UnitOfMeasure::DEGREE.conversionToSI()) {
@@ -4741,7 +5093,7 @@ AuthorityFactory::createPrimeMeridian(const std::string &code) const {
         const auto &longitude = row[1];
         const auto &uom_auth_name = row[2];
         const auto &uom_code = row[3];
-        const bool deprecated = row[4] == "1";
+        const bool deprecated = row.equals(4, "1");
 
         std::string normalized_uom_code(uom_code);
         const double normalized_value =
@@ -4841,7 +5193,7 @@ AuthorityFactory::createEllipsoid(const std::string &code) const {
         const auto &inv_flattening_str = row[4];
         const auto &semi_minor_axis_str = row[5];
         const auto &body = row[6];
-        const bool deprecated = row[7] == "1";
+        const bool deprecated = row.equals(7, "1");
         auto uom = d->createUnitOfMeasure(uom_auth_name, uom_code);
         auto props = d->createProperties(code, name, deprecated, {});
         if (!inv_flattening_str.empty()) {
@@ -4931,7 +5283,7 @@ void AuthorityFactory::createGeodeticDatumOrEnsemble(
         const auto &ensemble_accuracy = row[7];
         const auto &anchor = row[8];
         const auto &anchor_epoch = row[9];
-        const bool deprecated = row[10] == "1";
+        const bool deprecated = row.equals(10, "1");
 
         std::string massagedName;
         if (turnEnsembleAsDatum) {
@@ -5040,7 +5392,7 @@ void AuthorityFactory::createVerticalDatumOrEnsemble(
         const auto &ensemble_accuracy = row[3];
         const auto &anchor = row[4];
         const auto &anchor_epoch = row[5];
-        const bool deprecated = row[6] == "1";
+        const bool deprecated = row.equals(6, "1");
         auto props = d->createPropertiesSearchUsages("vertical_datum", code,
                                                      name, deprecated);
         if (!turnEnsembleAsDatum && !ensemble_accuracy.empty()) {
@@ -5123,7 +5475,7 @@ AuthorityFactory::createEngineeringDatum(const std::string &code) const {
         const auto &publication_date = row[1];
         const auto &anchor = row[2];
         const auto &anchor_epoch = row[3];
-        const bool deprecated = row[4] == "1";
+        const bool deprecated = row.equals(4, "1");
         auto props = d->createPropertiesSearchUsages("engineering_datum", code,
                                                      name, deprecated);
 
@@ -5174,7 +5526,7 @@ AuthorityFactory::createDatumEnsemble(const std::string &code,
         const std::string &gotType = row[0];
         const std::string &name = row[1];
         const std::string &ensembleAccuracy = row[2];
-        const bool deprecated = row[3] == "1";
+        const bool deprecated = row.equals(3, "1");
         if (type.empty() || type == gotType) {
             auto resMembers =
                 d->run("SELECT member_auth_name, member_code FROM " + gotType +
@@ -5483,7 +5835,7 @@ AuthorityFactory::createGeodeticCRS(const std::string &code,
         const auto &datum_auth_name = row[4];
         const auto &datum_code = row[5];
         const auto &text_definition = row[6];
-        const bool deprecated = row[7] == "1";
+        const bool deprecated = row.equals(7, "1");
         const auto &remarks = row[8];
 
         auto props = d->createPropertiesSearchUsages("geodetic_crs", code, name,
@@ -5599,7 +5951,7 @@ AuthorityFactory::createVerticalCRS(const std::string &code) const {
         const auto &cs_code = row[2];
         const auto &datum_auth_name = row[3];
         const auto &datum_code = row[4];
-        const bool deprecated = row[5] == "1";
+        const bool deprecated = row.equals(5, "1");
         auto cs =
             d->createFactory(cs_auth_name)->createCoordinateSystem(cs_code);
         datum::VerticalReferenceFramePtr datum;
@@ -5665,7 +6017,7 @@ AuthorityFactory::createEngineeringCRS(const std::string &code) const {
         const auto &cs_code = row[2];
         const auto &datum_auth_name = row[3];
         const auto &datum_code = row[4];
-        const bool deprecated = row[5] == "1";
+        const bool deprecated = row.equals(5, "1");
         auto cs =
             d->createFactory(cs_auth_name)->createCoordinateSystem(cs_code);
         auto datum = d->createFactory(datum_auth_name)
@@ -5773,7 +6125,8 @@ AuthorityFactory::createConversion(const std::string &code) const {
             values.emplace_back(operation::ParameterValue::create(
                 common::Measure(normalized_value, uom)));
         }
-        const bool deprecated = row[base_param_idx + N_MAX_PARAMS * 6] == "1";
+        const bool deprecated =
+            row.equals(base_param_idx + N_MAX_PARAMS * 6, "1");
 
         auto propConversion = d->createPropertiesSearchUsages(
             "conversion", code, name, deprecated);
@@ -5861,7 +6214,7 @@ AuthorityFactory::Private::createProjectedCRSEnd(const std::string &code,
         const auto &conversion_auth_name = row[5];
         const auto &conversion_code = row[6];
         const auto &text_definition = row[7];
-        const bool deprecated = row[8] == "1";
+        const bool deprecated = row.equals(8, "1");
 
         auto props = createPropertiesSearchUsages("projected_crs", code, name,
                                                   deprecated);
@@ -6000,7 +6353,7 @@ AuthorityFactory::Private::createDerivedProjectedCRSEnd(
         const auto &conversion_auth_name = row[5];
         const auto &conversion_code = row[6];
         const auto &text_definition = row[7];
-        const bool deprecated = row[8] == "1";
+        const bool deprecated = row.equals(8, "1");
 
         auto props = createPropertiesSearchUsages("derived_projected_crs", code,
                                                   name, deprecated);
@@ -6083,7 +6436,7 @@ AuthorityFactory::createCompoundCRS(const std::string &code) const {
         const auto &horiz_crs_code = row[2];
         const auto &vertical_crs_auth_name = row[3];
         const auto &vertical_crs_code = row[4];
-        const bool deprecated = row[5] == "1";
+        const bool deprecated = row.equals(5, "1");
 
         auto horizCRS =
             d->createFactory(horiz_crs_auth_name)
@@ -7418,8 +7771,8 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
         if (discardSuperseded) {
             const auto &replacement_auth_name = row[11];
             const auto &replacement_code = row[12];
-            const bool replacement_is_grid_transform = row[13] == "1";
-            const bool replacement_is_known_grid = row[14] == "1";
+            const bool replacement_is_grid_transform = row.equals(13, "1");
+            const bool replacement_is_known_grid = row.equals(14, "1");
             if (!replacement_auth_name.empty() &&
                 // Ignore supersession if the replacement uses a unknown grid
                 !(replacement_is_grid_transform &&
@@ -7435,10 +7788,10 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
 
         bool intersecting = true;
         try {
-            double south_lat = c_locale_stod(row[7]);
-            double west_lon = c_locale_stod(row[8]);
-            double north_lat = c_locale_stod(row[9]);
-            double east_lon = c_locale_stod(row[10]);
+            double south_lat = row.getDouble(7);
+            double west_lon = row.getDouble(8);
+            double north_lat = row.getDouble(9);
+            double east_lon = row.getDouble(10);
             auto transf_extent = metadata::Extent::createFromBBOX(
                 west_lon, south_lat, east_lon, north_lat);
 
@@ -7476,8 +7829,8 @@ AuthorityFactory::createFromCoordinateReferenceSystemCodes(
         if (discardSuperseded) {
             const auto &replacement_auth_name = row[11];
             const auto &replacement_code = row[12];
-            const bool replacement_is_grid_transform = row[13] == "1";
-            const bool replacement_is_known_grid = row[14] == "1";
+            const bool replacement_is_grid_transform = row.equals(13, "1");
+            const bool replacement_is_known_grid = row.equals(14, "1");
             if (!replacement_auth_name.empty() &&
                 // Ignore supersession if the replacement uses a unknown grid
                 !(replacement_is_grid_transform &&
@@ -7800,6 +8153,8 @@ AuthorityFactory::createFromCRSCodesWithIntermediates(
         skipIntermediateExtentIntersection
             ? "AND v1.deprecated = 0 AND v2.deprecated = 0 "
             : "AND v1.deprecated = 0 AND v2.deprecated = 0 "
+              // Cheap test on latitudes before the exact one
+              "AND south_lat1 <= north_lat2 AND south_lat2 <= north_lat1 "
               "AND intersects_bbox(south_lat1, west_lon1, north_lat1, "
               "east_lon1, south_lat2, west_lon2, north_lat2, "
               "east_lon2) = 1 ");
@@ -7843,6 +8198,23 @@ AuthorityFactory::createFromCRSCodesWithIntermediates(
                     const double east_lon = bbox->eastBoundLongitude();
                     if (south_lat != -90.0 || west_lon != -180.0 ||
                         north_lat != 90.0 || east_lon != 180.0) {
+                        if (d->context()->getPrivate()->canUseExtentRTree(
+                                *bbox)) {
+                            // Pre-filter with the R*Tree index
+                            for (const char *alias : {"a1", "a2"}) {
+                                additionalWhere +=
+                                    "AND EXISTS(SELECT 1 FROM "
+                                    "extent_rtree_code m JOIN extent_rtree r "
+                                    "ON r.id = m.id WHERE m.auth_name = ";
+                                additionalWhere += alias;
+                                additionalWhere += ".auth_name AND m.code = ";
+                                additionalWhere += alias;
+                                additionalWhere += ".code AND ";
+                                additionalWhere +=
+                                    getSqlExtentRTreeIntersects(*bbox, params);
+                                additionalWhere += ") ";
+                            }
+                        }
                         additionalWhere +=
                             "AND intersects_bbox(south_lat1, "
                             "west_lon1, north_lat1, east_lon1, ?, ?, ?, ?) AND "
@@ -8433,10 +8805,10 @@ AuthorityFactory::createBetweenGeodeticCRSWithDatumBasedIntermediates(
             trfm.name = row[4];
             const auto &datum_auth_name = row[5];
             const auto &datum_code = row[6];
-            trfm.west = c_locale_stod(row[7]);
-            trfm.south = c_locale_stod(row[8]);
-            trfm.east = c_locale_stod(row[9]);
-            trfm.north = c_locale_stod(row[10]);
+            trfm.west = row.getDouble(7);
+            trfm.south = row.getDouble(8);
+            trfm.east = row.getDouble(9);
+            trfm.north = row.getDouble(10);
             const std::string key =
                 std::string(datum_auth_name).append(":").append(datum_code);
             if (trfm.situation == "src_is_tgt" ||
@@ -8944,16 +9316,57 @@ AuthorityFactory::getDescriptionText(const std::string &code) const {
  * @throw FactoryException in case of error.
  */
 std::list<AuthorityFactory::CRSInfo> AuthorityFactory::getCRSInfoList() const {
+    return getCRSInfoList(nullptr);
+}
 
-    const auto getSqlArea = [](const char *table_name) {
-        std::string sql("LEFT JOIN usage u ON u.object_table_name = '");
+// ---------------------------------------------------------------------------
+
+//! @cond Doxygen_Suppress
+
+/** \brief Return a list of information on CRS objects
+ *
+ * Same as getCRSInfoList(), except that if intersectingBBox is not null, CRS
+ * whose area of use does not intersect it may be omitted, as well as CRS
+ * without area of use. This uses the R*Tree index on extents when available,
+ * and the caller must still check the area of use of the returned CRS.
+ *
+ * @throw FactoryException in case of error.
+ */
+std::list<AuthorityFactory::CRSInfo> AuthorityFactory::getCRSInfoList(
+    const metadata::GeographicBoundingBoxPtr &intersectingBBox) const {
+
+    ListOfParams params;
+    std::string sqlCandidateExtent;
+    const bool useExtentRTree =
+        intersectingBBox &&
+        d->context()->getPrivate()->canUseExtentRTree(*intersectingBBox);
+    if (useExtentRTree) {
+        // Start from the extents found in the R*Tree index
+        sqlCandidateExtent =
+            "WITH candidate_extent AS ("
+            "SELECT DISTINCT m.auth_name, m.code FROM extent_rtree r "
+            "JOIN extent_rtree_code m ON m.id = r.id WHERE ";
+        sqlCandidateExtent +=
+            getSqlExtentRTreeIntersects(*intersectingBBox, params);
+        sqlCandidateExtent += ") ";
+    }
+
+    const auto getSqlArea = [useExtentRTree](const char *table_name) {
+        const char *joinType = useExtentRTree ? "JOIN " : "LEFT JOIN ";
+        std::string sql(joinType);
+        sql += "usage u ON u.object_table_name = '";
         sql += table_name;
         sql += "' AND "
                "u.object_auth_name = c.auth_name AND "
-               "u.object_code = c.code "
-               "LEFT JOIN extent a "
+               "u.object_code = c.code ";
+        sql += joinType;
+        sql += "extent a "
                "ON a.auth_name = u.extent_auth_name AND "
                "a.code = u.extent_code ";
+        if (useExtentRTree) {
+            sql += "JOIN candidate_extent ce "
+                   "ON ce.auth_name = a.auth_name AND ce.code = a.code ";
+        }
         return sql;
     };
 
@@ -8971,14 +9384,14 @@ std::list<AuthorityFactory::CRSInfo> AuthorityFactory::getCRSInfoList() const {
         return sql;
     };
 
-    std::string sql = "SELECT * FROM ("
+    std::string sql = sqlCandidateExtent +
+                      "SELECT * FROM ("
                       "SELECT c.auth_name, c.code, c.name, c.type, "
                       "c.deprecated, "
                       "a.west_lon, a.south_lat, a.east_lon, a.north_lat, "
                       "a.description, NULL, cb.name FROM geodetic_crs c ";
     sql += getSqlArea("geodetic_crs");
     sql += getJoinCelestialBody("c");
-    ListOfParams params;
     if (d->hasAuthorityRestriction()) {
         sql += "WHERE c.auth_name = ? ";
         params.emplace_back(d->authority());
@@ -9071,15 +9484,15 @@ std::list<AuthorityFactory::CRSInfo> AuthorityFactory::getCRSInfoList() const {
         } else if (type == CRS_SUBTYPE_DERIVED_PROJECTED) {
             info.type = AuthorityFactory::ObjectType::DERIVED_PROJECTED_CRS;
         }
-        info.deprecated = row[4] == "1";
+        info.deprecated = row.equals(4, "1");
         if (row[5].empty()) {
             info.bbox_valid = false;
         } else {
             info.bbox_valid = true;
-            info.west_lon_degree = c_locale_stod(row[5]);
-            info.south_lat_degree = c_locale_stod(row[6]);
-            info.east_lon_degree = c_locale_stod(row[7]);
-            info.north_lat_degree = c_locale_stod(row[8]);
+            info.west_lon_degree = row.getDouble(5);
+            info.south_lat_degree = row.getDouble(6);
+            info.east_lon_degree = row.getDouble(7);
+            info.north_lat_degree = row.getDouble(8);
         }
         info.areaName = row[9];
         info.projectionMethodName = row[10];
@@ -9088,6 +9501,7 @@ std::list<AuthorityFactory::CRSInfo> AuthorityFactory::getCRSInfoList() const {
     }
     return res;
 }
+//! @endcond
 
 // ---------------------------------------------------------------------------
 
@@ -9145,9 +9559,9 @@ std::list<AuthorityFactory::UnitInfo> AuthorityFactory::getUnitList() const {
         } else {
             info.category = raw_category;
         }
-        info.convFactor = row[4].empty() ? 0 : c_locale_stod(row[4]);
+        info.convFactor = row[4].empty() ? 0 : row.getDouble(4);
         info.projShortName = row[5];
-        info.deprecated = row[6] == "1";
+        info.deprecated = row.equals(6, "1");
         res.emplace_back(info);
     }
     return res;
@@ -9627,7 +10041,8 @@ AuthorityFactory::createObjectsFromNameEx(
                 const auto canonicalizedName(
                     metadata::Identifier::canonicalizeName(name));
                 auto &v = mapCanonicalizeGRFName[canonicalizedName];
-                if (deprecatedStr == "0" || v.empty() || v.front()[4] == "1") {
+                if (deprecatedStr == "0" || v.empty() ||
+                    v.front().equals(4, "1")) {
                     v.push_back(row);
                 }
             }
@@ -9690,7 +10105,14 @@ AuthorityFactory::createObjectsFromNameEx(
             }
         }
     } else {
-        auto sqlRes = d->run(sql, params);
+        SQLResultSet sqlRes;
+        if (approximateMatch) {
+            sqlRes = d->findObjectsByApproximateName(
+                listTableNameType, searchedNameWithoutDeprecated,
+                canonicalizedSearchedName, deprecated, useAliases);
+        } else {
+            sqlRes = d->run(sql, params);
+        }
         bool isFirst = true;
         bool firstIsDeprecated = false;
         size_t countExactMatch = 0;
@@ -9698,20 +10120,6 @@ AuthorityFactory::createObjectsFromNameEx(
         std::size_t hashCodeFirstMatch = 0;
         for (const auto &row : sqlRes) {
             const auto &name = row[3];
-            if (approximateMatch) {
-                bool match = ci_find(name, searchedNameWithoutDeprecated) !=
-                             std::string::npos;
-                if (!match) {
-                    const auto canonicalizedName(
-                        metadata::Identifier::canonicalizeName(name));
-                    match =
-                        ci_find(canonicalizedName, canonicalizedSearchedName) !=
-                        std::string::npos;
-                }
-                if (!match) {
-                    continue;
-                }
-            }
             const auto &table_name = row[0];
             const auto &auth_name = row[1];
             const auto &code = row[2];
@@ -10131,6 +10539,47 @@ static std::string buildSqlLookForAuthNameCode(
 
 // ---------------------------------------------------------------------------
 
+//! @cond Doxygen_Suppress
+// Compute the fingerprint of a projected CRS, as stored in the
+// projected_crs_fingerprint table (see data/sql/projected_crs_fingerprint.sql)
+static bool getProjectedCRSFingerprint(const crs::ProjectedCRSNNPtr &crs,
+                                       double &semiMajorAxis,
+                                       double &parametersHash) {
+    semiMajorAxis = static_cast<double>(std::llround(
+        crs->baseCRS()->ellipsoid()->semiMajorAxis().getSIValue()));
+    std::int64_t hash = 0;
+    for (const auto &genOpParamvalue :
+         crs->derivingConversionRef()->parameterValues()) {
+        auto opParamvalue =
+            dynamic_cast<const operation::OperationParameterValue *>(
+                genOpParamvalue.get());
+        if (!opParamvalue) {
+            return false;
+        }
+        const auto &parameterValue = opParamvalue->parameterValue();
+        int paramEPSGCode = opParamvalue->parameter()->getEPSGCode();
+        if (paramEPSGCode == 0 || parameterValue->type() !=
+                                      operation::ParameterValue::Type::MEASURE) {
+            return false;
+        }
+        if (paramEPSGCode == EPSG_CODE_PARAMETER_LATITUDE_2ND_STD_PARALLEL) {
+            paramEPSGCode = EPSG_CODE_PARAMETER_LATITUDE_1ST_STD_PARALLEL;
+        }
+        const auto &measure = parameterValue->value();
+        const double scale =
+            measure.unit().type() == common::UnitOfMeasure::Type::LINEAR
+                ? 1e2
+                : 1e6;
+        hash += static_cast<std::int64_t>(paramEPSGCode) * 1000003 +
+                std::llround(measure.getSIValue() * scale);
+    }
+    parametersHash = static_cast<double>(hash);
+    return true;
+}
+//! @endcond
+
+// ---------------------------------------------------------------------------
+
 //! @cond Doxygen_Suppress
 std::list<crs::ProjectedCRSNNPtr>
 AuthorityFactory::createProjectedCRSFromExisting(
@@ -10300,7 +10749,39 @@ AuthorityFactory::createProjectedCRSFromExisting(
         }
         sql += "))";
     }
-    auto sqlRes = d->run(sql, params);
+
+    // Look first for the projected CRS with the same fingerprint. Only run the
+    // above broader query, which also returns near matches, if there are none.
+    SQLResultSet sqlRes;
+    double semiMajorAxisKey = 0;
+    double parametersHash = 0;
+    if (d->context()->getPrivate()->canUseProjectedCRSFingerprint() &&
+        getProjectedCRSFingerprint(crs, semiMajorAxisKey, parametersHash)) {
+        std::string sqlFingerprint(
+            "SELECT projected_crs.auth_name, projected_crs.code, "
+            "projected_crs.name FROM projected_crs_fingerprint fp "
+            "JOIN projected_crs ON "
+            "projected_crs.auth_name = fp.auth_name AND "
+            "projected_crs.code = fp.code "
+            "WHERE fp.method_code = ? AND fp.semi_major_axis = ? AND "
+            "fp.parameters_hash = ?");
+        ListOfParams paramsFingerprint{methodEPSGCode, semiMajorAxisKey,
+                                       parametersHash};
+        if (!candidatesGeodCRS.empty()) {
+            sqlFingerprint += " AND ";
+            sqlFingerprint += buildSqlLookForAuthNameCode(
+                candidatesGeodCRS, paramsFingerprint,
+                "projected_crs.geodetic_crs_");
+        }
+        if (d->hasAuthorityRestriction()) {
+            sqlFingerprint += " AND projected_crs.auth_name = ?";
+            paramsFingerprint.emplace_back(d->authority());
+        }
+        sqlRes = d->run(sqlFingerprint, paramsFingerprint);
+    }
+    if (sqlRes.empty()) {
+        sqlRes = d->run(sql, params);
+    }
 
     for (const auto &row : sqlRes) {
         const auto &name = row[2];
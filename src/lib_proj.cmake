@@ -200,6 +200,7 @@ set(SRC_LIBPROJ_CORE
   coordinates.cpp
   create.cpp
   crs_to_crs.cpp
+  crs_to_crs_cache.cpp
   ctx.cpp
   datum_set.cpp
   datums.cpp
@@ -247,6 +248,7 @@ set(SRC_LIBPROJ_CORE
   sqlite3_utils.cpp
   tracing.cpp
   trans.cpp
+  trans_approx.cpp
   trans_bounds.cpp
   tsfn.cpp
   units.cpp
@@ -198,8 +198,10 @@ void proj_cleanup() {
         cpp_context->closeDb();
     }
 
+    pj_stop_grid_prefetch();
     pj_clear_initcache();
     FileManager::clearMemoryCache();
+    pj_clear_grid_block_cache();
     pj_clear_hgridshift_knowngrids_cache();
     pj_clear_vgridshift_knowngrids_cache();
     pj_clear_gridshift_knowngrids_cache();
@@ -125,8 +125,9 @@ struct FileProperties {
 
 class NetworkChunkCache {
   public:
-    void insert(PJ_CONTEXT *ctx, const std::string &url,
-                unsigned long long chunkIdx, std::vector<unsigned char> &&data);
+    std::shared_ptr<std::vector<unsigned char>>
+    insert(PJ_CONTEXT *ctx, const std::string &url, unsigned long long chunkIdx,
+           std::vector<unsigned char> &&data);
 
     std::shared_ptr<std::vector<unsigned char>>
     get(PJ_CONTEXT *ctx, const std::string &url, unsigned long long chunkIdx);
@@ -141,6 +142,10 @@ class NetworkChunkCache {
     static void clearDiskChunkCache(PJ_CONTEXT *ctx);
 
   private:
+    void insertInDiskCache(PJ_CONTEXT *ctx, const std::string &url,
+                           unsigned long long chunkIdx,
+                           const std::vector<unsigned char> &data);
+
     struct Key {
         std::string url;
         unsigned long long chunkIdx;
@@ -794,19 +799,28 @@ bool DiskChunkCache::move_to_tail(sqlite3_int64 chunk_id) {
 
 // ---------------------------------------------------------------------------
 
-void NetworkChunkCache::insert(PJ_CONTEXT *ctx, const std::string &url,
-                               unsigned long long chunkIdx,
-                               std::vector<unsigned char> &&data) {
+std::shared_ptr<std::vector<unsigned char>>
+NetworkChunkCache::insert(PJ_CONTEXT *ctx, const std::string &url,
+                          unsigned long long chunkIdx,
+                          std::vector<unsigned char> &&data) {
     auto dataPtr(std::make_shared<std::vector<unsigned char>>(std::move(data)));
     cache_.insert(Key(url, chunkIdx), dataPtr);
+    insertInDiskCache(ctx, url, chunkIdx, *dataPtr);
+    return dataPtr;
+}
 
+// ---------------------------------------------------------------------------
+
+void NetworkChunkCache::insertInDiskCache(
+    PJ_CONTEXT *ctx, const std::string &url, unsigned long long chunkIdx,
+    const std::vector<unsigned char> &data) {
     auto diskCache = DiskChunkCache::open(ctx);
     if (!diskCache)
         return;
     auto hDB = diskCache->handle();
 
     // Always insert DOWNLOAD_CHUNK_SIZE bytes to avoid fragmentation
-    std::vector<unsigned char> blob(*dataPtr);
+    std::vector<unsigned char> blob(data);
     assert(blob.size() <= DOWNLOAD_CHUNK_SIZE);
     blob.resize(DOWNLOAD_CHUNK_SIZE);
 
@@ -848,7 +862,7 @@ void NetworkChunkCache::insert(PJ_CONTEXT *ctx, const std::string &url,
     // least recently used.
     const auto reuseExistingEntry =
         [ctx, &blob, &diskCache, hDB, &url, chunkIdx,
-         &dataPtr](std::unique_ptr<SQLiteStatement> &stmtIn) {
+         &data](std::unique_ptr<SQLiteStatement> &stmtIn) {
             const auto chunk_id = stmtIn->getInt64();
             const auto data_id = stmtIn->getInt64();
             if (data_id <= 0) {
@@ -878,7 +892,7 @@ void NetworkChunkCache::insert(PJ_CONTEXT *ctx, const std::string &url,
                 return;
             l_stmt->bindText(url.c_str());
             l_stmt->bindInt64(chunkIdx * DOWNLOAD_CHUNK_SIZE);
-            l_stmt->bindInt64(dataPtr->size());
+            l_stmt->bindInt64(data.size());
             l_stmt->bindInt64(data_id);
             l_stmt->bindInt64(chunk_id);
             {
@@ -963,7 +977,7 @@ void NetworkChunkCache::insert(PJ_CONTEXT *ctx, const std::string &url,
     stmt->bindText(url.c_str());
     stmt->bindInt64(chunkIdx * DOWNLOAD_CHUNK_SIZE);
     stmt->bindInt64(chunk_data_id);
-    stmt->bindInt64(dataPtr->size());
+    stmt->bindInt64(data.size());
     {
         const auto ret = stmt->execute();
         if (ret != SQLITE_DONE) {
@@ -1247,6 +1261,9 @@ class NetworkFile : public File {
     NetworkFile(const NetworkFile &) = delete;
     NetworkFile &operator=(const NetworkFile &) = delete;
 
+    std::shared_ptr<std::vector<unsigned char>>
+    download(unsigned long long chunkIdx, size_t nChunks, size_t &nRead);
+
   protected:
     NetworkFile(PJ_CONTEXT *ctx, const std::string &url,
                 PROJ_NETWORK_HANDLE *handle,
@@ -1265,6 +1282,7 @@ class NetworkFile : public File {
     unsigned long long tell() override;
     void reassign_context(PJ_CONTEXT *ctx) override;
     bool hasChanged() const override { return m_hasChanged; }
+    void prefetch(const std::vector<FileRange> &ranges) override;
 
     static std::unique_ptr<File> open(PJ_CONTEXT *ctx, const char *filename);
 
@@ -1346,6 +1364,70 @@ std::unique_ptr<File> pj_network_file_open(PJ_CONTEXT *ctx,
 
 // ---------------------------------------------------------------------------
 
+std::shared_ptr<std::vector<unsigned char>>
+NetworkFile::download(unsigned long long chunkIdx, size_t nChunks,
+                      size_t &nRead) {
+    const auto offsetToDownload = chunkIdx * DOWNLOAD_CHUNK_SIZE;
+    std::vector<unsigned char> region(nChunks * DOWNLOAD_CHUNK_SIZE);
+    nRead = 0;
+    std::string errorBuffer;
+    errorBuffer.resize(1024);
+    if (!m_handle) {
+        m_handle = m_ctx->networking.open(
+            m_ctx, m_url.c_str(), offsetToDownload, region.size(), &region[0],
+            &nRead, errorBuffer.size(), &errorBuffer[0],
+            m_ctx->networking.user_data);
+        if (!m_handle) {
+            proj_context_errno_set(m_ctx, PROJ_ERR_OTHER_NETWORK_ERROR);
+            return nullptr;
+        }
+    } else {
+        nRead = m_ctx->networking.read_range(
+            m_ctx, m_handle, offsetToDownload, region.size(), &region[0],
+            errorBuffer.size(), &errorBuffer[0], m_ctx->networking.user_data);
+    }
+    if (nRead == 0) {
+        errorBuffer.resize(strlen(errorBuffer.data()));
+        if (!errorBuffer.empty()) {
+            pj_log(m_ctx, PJ_LOG_ERROR, "Cannot read in %s: %s", m_url.c_str(),
+                   errorBuffer.c_str());
+        }
+        proj_context_errno_set(m_ctx, PROJ_ERR_OTHER_NETWORK_ERROR);
+        return nullptr;
+    }
+
+    if (!m_hasChanged) {
+        FileProperties props;
+        if (get_props_from_headers(m_ctx, m_handle, props)) {
+            if (props.size != m_props.size ||
+                props.lastModified != m_props.lastModified ||
+                props.etag != m_props.etag) {
+                gNetworkFileProperties.insert(m_ctx, m_url, props);
+                gNetworkChunkCache.clearMemoryCache();
+                m_hasChanged = true;
+            }
+        }
+    }
+
+    // Split the downloaded region into chunks, and hand back the first one
+    // so that the caller does not need to look it up again in the cache.
+    std::shared_ptr<std::vector<unsigned char>> firstChunk;
+    const size_t nDownloadedChunks =
+        (nRead + DOWNLOAD_CHUNK_SIZE - 1) / DOWNLOAD_CHUNK_SIZE;
+    for (size_t i = 0; i < nDownloadedChunks; i++) {
+        std::vector<unsigned char> chunk(
+            region.data() + i * DOWNLOAD_CHUNK_SIZE,
+            region.data() + std::min((i + 1) * DOWNLOAD_CHUNK_SIZE, nRead));
+        auto pChunk = gNetworkChunkCache.insert(m_ctx, m_url, chunkIdx + i,
+                                                std::move(chunk));
+        if (i == 0)
+            firstChunk = std::move(pChunk);
+    }
+    return firstChunk;
+}
+
+// ---------------------------------------------------------------------------
+
 size_t NetworkFile::read(void *buffer, size_t sizeBytes) {
 
     if (sizeBytes == 0)
@@ -1355,11 +1437,10 @@ size_t NetworkFile::read(void *buffer, size_t sizeBytes) {
     while (sizeBytes) {
         const auto chunkIdxToDownload = iterOffset / DOWNLOAD_CHUNK_SIZE;
         const auto offsetToDownload = chunkIdxToDownload * DOWNLOAD_CHUNK_SIZE;
-        std::vector<unsigned char> region;
+        // Hold a reference on the cached chunk rather than copying it, so
+        // that a cache hit only costs the copy of the requested bytes.
         auto pChunk = gNetworkChunkCache.get(m_ctx, m_url, chunkIdxToDownload);
-        if (pChunk != nullptr) {
-            region = *pChunk;
-        } else {
+        if (pChunk == nullptr) {
             if (offsetToDownload == m_lastDownloadedOffset) {
                 // In case of consecutive reads (of small size), we use a
                 // heuristic that we will read the file sequentially, so
@@ -1397,72 +1478,23 @@ size_t NetworkFile::read(void *buffer, size_t sizeBytes) {
             if (m_nBlocksToDownload > MAX_CHUNKS)
                 m_nBlocksToDownload = MAX_CHUNKS;
 
-            region.resize(m_nBlocksToDownload * DOWNLOAD_CHUNK_SIZE);
             size_t nRead = 0;
-            std::string errorBuffer;
-            errorBuffer.resize(1024);
-            if (!m_handle) {
-                m_handle = m_ctx->networking.open(
-                    m_ctx, m_url.c_str(), offsetToDownload,
-                    m_nBlocksToDownload * DOWNLOAD_CHUNK_SIZE, &region[0],
-                    &nRead, errorBuffer.size(), &errorBuffer[0],
-                    m_ctx->networking.user_data);
-                if (!m_handle) {
-                    proj_context_errno_set(m_ctx, PROJ_ERR_OTHER_NETWORK_ERROR);
-                    return 0;
-                }
-            } else {
-                nRead = m_ctx->networking.read_range(
-                    m_ctx, m_handle, offsetToDownload,
-                    m_nBlocksToDownload * DOWNLOAD_CHUNK_SIZE, &region[0],
-                    errorBuffer.size(), &errorBuffer[0],
-                    m_ctx->networking.user_data);
-            }
-            if (nRead == 0) {
-                errorBuffer.resize(strlen(errorBuffer.data()));
-                if (!errorBuffer.empty()) {
-                    pj_log(m_ctx, PJ_LOG_ERROR, "Cannot read in %s: %s",
-                           m_url.c_str(), errorBuffer.c_str());
-                }
-                proj_context_errno_set(m_ctx, PROJ_ERR_OTHER_NETWORK_ERROR);
+            pChunk = download(chunkIdxToDownload, m_nBlocksToDownload, nRead);
+            if (pChunk == nullptr)
                 return 0;
-            }
-
-            if (!m_hasChanged) {
-                FileProperties props;
-                if (get_props_from_headers(m_ctx, m_handle, props)) {
-                    if (props.size != m_props.size ||
-                        props.lastModified != m_props.lastModified ||
-                        props.etag != m_props.etag) {
-                        gNetworkFileProperties.insert(m_ctx, m_url, props);
-                        gNetworkChunkCache.clearMemoryCache();
-                        m_hasChanged = true;
-                    }
-                }
-            }
-
-            region.resize(nRead);
             m_lastDownloadedOffset = offsetToDownload + nRead;
-
-            const auto nChunks =
-                (region.size() + DOWNLOAD_CHUNK_SIZE - 1) / DOWNLOAD_CHUNK_SIZE;
-            for (size_t i = 0; i < nChunks; i++) {
-                std::vector<unsigned char> chunk(
-                    region.data() + i * DOWNLOAD_CHUNK_SIZE,
-                    region.data() +
-                        std::min((i + 1) * DOWNLOAD_CHUNK_SIZE, region.size()));
-                gNetworkChunkCache.insert(m_ctx, m_url, chunkIdxToDownload + i,
-                                          std::move(chunk));
-            }
         }
-        const size_t nToCopy = static_cast<size_t>(
-            std::min(static_cast<unsigned long long>(sizeBytes),
-                     region.size() - (iterOffset - offsetToDownload)));
-        memcpy(buffer, region.data() + iterOffset - offsetToDownload, nToCopy);
+        const auto &chunk = *pChunk;
+        const size_t offsetInChunk =
+            static_cast<size_t>(iterOffset - offsetToDownload);
+        if (offsetInChunk >= chunk.size())
+            break;
+        const size_t nToCopy = std::min(sizeBytes, chunk.size() - offsetInChunk);
+        memcpy(buffer, chunk.data() + offsetInChunk, nToCopy);
         buffer = static_cast<char *>(buffer) + nToCopy;
         iterOffset += nToCopy;
         sizeBytes -= nToCopy;
-        if (region.size() < static_cast<size_t>(DOWNLOAD_CHUNK_SIZE) &&
+        if (chunk.size() < static_cast<size_t>(DOWNLOAD_CHUNK_SIZE) &&
             sizeBytes != 0) {
             break;
         }
@@ -1475,6 +1507,61 @@ size_t NetworkFile::read(void *buffer, size_t sizeBytes) {
 
 // ---------------------------------------------------------------------------
 
+void NetworkFile::prefetch(const std::vector<FileRange> &ranges) {
+    if (m_hasChanged)
+        return;
+
+    // Collect the chunks covering the requested ranges that are not already
+    // in the cache.
+    std::vector<unsigned long long> chunks;
+    for (const auto &range : ranges) {
+        if (range.size == 0 || range.offset >= m_props.size)
+            continue;
+        const auto endOffset =
+            std::min(range.offset + range.size, m_props.size);
+        for (auto chunkIdx = range.offset / DOWNLOAD_CHUNK_SIZE;
+             chunkIdx * DOWNLOAD_CHUNK_SIZE < endOffset; ++chunkIdx) {
+            chunks.push_back(chunkIdx);
+        }
+    }
+    std::sort(chunks.begin(), chunks.end());
+    chunks.erase(std::unique(chunks.begin(), chunks.end()), chunks.end());
+    chunks.erase(std::remove_if(chunks.begin(), chunks.end(),
+                                [this](unsigned long long chunkIdx) {
+                                    return gNetworkChunkCache.get(
+                                               m_ctx, m_url, chunkIdx) !=
+                                           nullptr;
+                                }),
+                 chunks.end());
+
+    // Coalesce neighbouring chunks into a single range request. Small holes
+    // are downloaded too, as this is cheaper than an extra round trip.
+    constexpr unsigned long long MAX_GAP_CHUNKS = 2;
+    const int errnoBefore = proj_context_errno(m_ctx);
+    size_t i = 0;
+    while (i < chunks.size()) {
+        const auto firstChunk = chunks[i];
+        auto lastChunk = firstChunk;
+        size_t j = i + 1;
+        while (j < chunks.size() &&
+               chunks[j] - lastChunk <= MAX_GAP_CHUNKS + 1 &&
+               chunks[j] - firstChunk < MAX_CHUNKS) {
+            lastChunk = chunks[j];
+            ++j;
+        }
+        const auto nChunks = static_cast<size_t>(lastChunk - firstChunk + 1);
+        size_t nRead = 0;
+        if (download(firstChunk, nChunks, nRead) == nullptr)
+            break;
+        i = j;
+    }
+    // Prefetching is only a hint: a failure will be reported by the
+    // subsequent read() if the data is really needed.
+    proj_context_errno_set(m_ctx, errnoBefore);
+}
+
+// ---------------------------------------------------------------------------
+
 bool NetworkFile::seek(unsigned long long offset, int whence) {
     if (whence == SEEK_SET) {
         m_pos = offset;
@@ -10,6 +10,12 @@
 #include "proj.h"
 #include "proj_internal.h"
 
+/* set the length of the name part of a parameter list entry, so that */
+/* lookups do not need to parse the entry again */
+static void pj_param_set_key_len(paralist *item) {
+    item->key_len = strcspn(item->param, "=");
+}
+
 /* create parameter list entry */
 paralist *pj_mkparam(const char *str) {
     paralist *newitem;
@@ -21,6 +27,7 @@ paralist *pj_mkparam(const char *str) {
         if (*str == '+')
             ++str;
         (void)strcpy(newitem->param, str);
+        pj_param_set_key_len(newitem);
     }
     return newitem;
 }
@@ -62,6 +69,7 @@ paralist *pj_mkparam_ws(const char *str, const char **next_str) {
     if (nullptr == newitem)
         return nullptr;
     memcpy(newitem->param, str, len);
+    pj_param_set_key_len(newitem);
 
     newitem->used = 0;
     newitem->next = nullptr;
@@ -87,20 +95,19 @@ paralist *pj_param_exists(paralist *list, const char *parameter) {
     obviously not an issue).
     ***************************************************************************************/
     paralist *next = list;
-    const char *c = strchr(parameter, '=');
-    size_t len = strlen(parameter);
-    if (c)
-        len = c - parameter;
+    const size_t len = strcspn(parameter, "=");
     if (list == nullptr)
         return nullptr;
+    const bool is_step = len == 4 && 0 == strcmp(parameter, "step");
 
+    /* Comparing the pre-computed name lengths first avoids most string */
+    /* comparisons */
     for (next = list; next; next = next->next) {
-        if (0 == strncmp(parameter, next->param, len) &&
-            (next->param[len] == '=' || next->param[len] == 0)) {
+        if (next->key_len == len && 0 == memcmp(parameter, next->param, len)) {
             next->used = 1;
             return next;
         }
-        if (0 == strcmp(parameter, "step"))
+        if (is_step)
             return nullptr;
     }
 
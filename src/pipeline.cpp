@@ -97,6 +97,7 @@ Thomas Knudsen, thokn@sdfe.dk, 2016-05-20
 *
 ********************************************************************************/
 
+#include <algorithm>
 #include <math.h>
 #include <stack>
 #include <stddef.h>
@@ -111,6 +112,9 @@ PROJ_HEAD(pipeline, "Transformation pipeline manager");
 PROJ_HEAD(pop, "Retrieve coordinate value from pipeline stack");
 PROJ_HEAD(push, "Save coordinate value on pipeline stack");
 
+static void push(PJ_COORD &point, PJ *P);
+static void pop(PJ_COORD &point, PJ *P);
+
 /* Projection specific elements for the PJ object */
 namespace { // anonymous namespace
 
@@ -118,12 +122,13 @@ struct Step {
     PJ *pj = nullptr;
     bool omit_fwd = false;
     bool omit_inv = false;
+    int fused_run = -1; /* index in Pipeline::fused_runs, or -1 */
 
     Step(PJ *pjIn, bool omitFwdIn, bool omitInvIn)
         : pj(pjIn), omit_fwd(omitFwdIn), omit_inv(omitInvIn) {}
     Step(Step &&other)
         : pj(std::move(other.pj)), omit_fwd(other.omit_fwd),
-          omit_inv(other.omit_inv) {
+          omit_inv(other.omit_inv), fused_run(other.fused_run) {
         other.pj = nullptr;
     }
     Step(const Step &) = delete;
@@ -132,10 +137,21 @@ struct Step {
     ~Step() { proj_destroy(pj); }
 };
 
+/* Consecutive steps that together amount to an affine map of x, y, z,  */
+/* and are run as a single matrix product. The steps are kept in place,  */
+/* and used for coordinates the matrix cannot handle (HUGE_VAL input).   */
+struct FusedRun {
+    size_t first = 0;
+    size_t last = 0;
+    double fwd[3][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}};
+    double inv[3][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}};
+};
+
 struct Pipeline {
     char **argv = nullptr;
     char **current_argv = nullptr;
     std::vector<Step> steps{};
+    std::vector<FusedRun> fused_runs{};
     std::stack<double> stack[4];
 };
 
@@ -149,6 +165,10 @@ struct PushPop {
 
 static void pipeline_forward_4d(PJ_COORD &point, PJ *P);
 static void pipeline_reverse_4d(PJ_COORD &point, PJ *P);
+static void pipeline_forward_4d_batch(PJ_COORD *coo, size_t n, int *errors,
+                                      PJ *P);
+static void pipeline_reverse_4d_batch(PJ_COORD *coo, size_t n, int *errors,
+                                      PJ *P);
 static PJ_XYZ pipeline_forward_3d(PJ_LPZ lpz, PJ *P);
 static PJ_LPZ pipeline_reverse_3d(PJ_XYZ xyz, PJ *P);
 static PJ_XY pipeline_forward(PJ_LP lp, PJ *P);
@@ -160,9 +180,33 @@ static void pipeline_reassign_context(PJ *P, PJ_CONTEXT *ctx) {
         proj_assign_context(step.pj, ctx);
 }
 
+static inline bool has_huge_xyz(const PJ_COORD &point) {
+    return point.v[0] == HUGE_VAL || point.v[1] == HUGE_VAL ||
+           point.v[2] == HUGE_VAL;
+}
+
+static inline void apply_affine(const double m[3][4], PJ_COORD &point) {
+    const double x = point.v[0];
+    const double y = point.v[1];
+    const double z = point.v[2];
+    point.v[0] = m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3];
+    point.v[1] = m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3];
+    point.v[2] = m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3];
+}
+
 static void pipeline_forward_4d(PJ_COORD &point, PJ *P) {
     auto pipeline = static_cast<struct Pipeline *>(P->opaque);
-    for (auto &step : pipeline->steps) {
+    const auto &steps = pipeline->steps;
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const auto &step = steps[i];
+        if (step.fused_run >= 0) {
+            const auto &run = pipeline->fused_runs[step.fused_run];
+            if (i == run.first && !has_huge_xyz(point)) {
+                apply_affine(run.fwd, point);
+                i = run.last;
+                continue;
+            }
+        }
         if (!step.omit_fwd) {
             if (!step.pj->inverted)
                 pj_fwd4d(point, step.pj);
@@ -177,9 +221,17 @@ static void pipeline_forward_4d(PJ_COORD &point, PJ *P) {
 
 static void pipeline_reverse_4d(PJ_COORD &point, PJ *P) {
     auto pipeline = static_cast<struct Pipeline *>(P->opaque);
-    for (auto iterStep = pipeline->steps.rbegin();
-         iterStep != pipeline->steps.rend(); ++iterStep) {
-        const auto &step = *iterStep;
+    const auto &steps = pipeline->steps;
+    for (size_t i = steps.size(); i-- > 0;) {
+        const auto &step = steps[i];
+        if (step.fused_run >= 0) {
+            const auto &run = pipeline->fused_runs[step.fused_run];
+            if (i == run.last && !has_huge_xyz(point)) {
+                apply_affine(run.inv, point);
+                i = run.first;
+                continue;
+            }
+        }
         if (!step.omit_inv) {
             if (step.pj->inverted)
                 pj_fwd4d(point, step.pj);
@@ -192,6 +244,77 @@ static void pipeline_reverse_4d(PJ_COORD &point, PJ *P) {
     }
 }
 
+/* Apply a fused run to a block. Points with a HUGE_VAL component go */
+/* through the original steps, so that errors are reported the same */
+/* way as without fusion.                                            */
+static void fused_run_batch(PJ_COORD *coo, size_t n, int *errors,
+                            const Pipeline *pipeline, const FusedRun &run,
+                            PJ_DIRECTION direction) {
+    const auto &steps = pipeline->steps;
+    const auto &m = direction == PJ_FWD ? run.fwd : run.inv;
+    for (size_t i = 0; i < n; i++) {
+        if (coo[i].v[0] == HUGE_VAL)
+            continue;
+        if (!has_huge_xyz(coo[i])) {
+            apply_affine(m, coo[i]);
+            continue;
+        }
+        for (size_t k = 0; k <= run.last - run.first; k++) {
+            const auto &step = steps[direction == PJ_FWD ? run.first + k
+                                                         : run.last - k];
+            if ((direction == PJ_FWD) == !step.pj->inverted)
+                pj_fwd4d_batch(coo + i, 1, errors + i, step.pj);
+            else
+                pj_inv4d_batch(coo + i, 1, errors + i, step.pj);
+        }
+    }
+}
+
+/* Run each step over the whole block before moving on to the next one. */
+/* Points that fail in a step are set to HUGE_VAL, and skipped by the    */
+/* subsequent steps.                                                     */
+static void pipeline_forward_4d_batch(PJ_COORD *coo, size_t n, int *errors,
+                                      PJ *P) {
+    auto pipeline = static_cast<struct Pipeline *>(P->opaque);
+    const auto &steps = pipeline->steps;
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const auto &step = steps[i];
+        if (step.fused_run >= 0) {
+            const auto &run = pipeline->fused_runs[step.fused_run];
+            fused_run_batch(coo, n, errors, pipeline, run, PJ_FWD);
+            i = run.last;
+            continue;
+        }
+        if (!step.omit_fwd) {
+            if (!step.pj->inverted)
+                pj_fwd4d_batch(coo, n, errors, step.pj);
+            else
+                pj_inv4d_batch(coo, n, errors, step.pj);
+        }
+    }
+}
+
+static void pipeline_reverse_4d_batch(PJ_COORD *coo, size_t n, int *errors,
+                                      PJ *P) {
+    auto pipeline = static_cast<struct Pipeline *>(P->opaque);
+    const auto &steps = pipeline->steps;
+    for (size_t i = steps.size(); i-- > 0;) {
+        const auto &step = steps[i];
+        if (step.fused_run >= 0) {
+            const auto &run = pipeline->fused_runs[step.fused_run];
+            fused_run_batch(coo, n, errors, pipeline, run, PJ_INV);
+            i = run.first;
+            continue;
+        }
+        if (!step.omit_inv) {
+            if (step.pj->inverted)
+                pj_fwd4d_batch(coo, n, errors, step.pj);
+            else
+                pj_inv4d_batch(coo, n, errors, step.pj);
+        }
+    }
+}
+
 static PJ_XYZ pipeline_forward_3d(PJ_LPZ lpz, PJ *P) {
     PJ_COORD point = {{0, 0, 0, 0}};
     point.lpz = lpz;
@@ -358,6 +481,124 @@ static void set_ellipsoid(PJ *P) {
     proj_errno_restore(P, err);
 }
 
+/* Whether the prepare and finalize stages that pj_fwd4d() (PJ_FWD) or  */
+/* pj_inv4d() (PJ_INV) run around the step leave coordinates unchanged, */
+/* except for the HUGE_VAL checks                                       */
+static bool step_io_is_neutral(const PJ *Q, PJ_DIRECTION direction) {
+    if (Q->axisswap || Q->cart || Q->cart_wgs84 || Q->helmert ||
+        Q->hgridshift || Q->vgridshift || Q->geoc || Q->is_geocent)
+        return false;
+
+    const bool fwd = direction == PJ_FWD;
+    const auto in = fwd ? Q->left : Q->right;
+    const auto out = fwd ? Q->right : Q->left;
+    const bool skip_prepare =
+        (fwd ? Q->skip_fwd_prepare : Q->skip_inv_prepare) != 0;
+    const bool skip_finalize =
+        (fwd ? Q->skip_fwd_finalize : Q->skip_inv_finalize) != 0;
+
+    if (!(skip_prepare && skip_finalize) &&
+        (Q->to_meter != 1 || Q->fr_meter != 1 || Q->vto_meter != 1 ||
+         Q->vfr_meter != 1 || Q->x0 != 0 || Q->y0 != 0 || Q->z0 != 0))
+        return false;
+
+    if (!skip_prepare) {
+        if (fwd ? in == PJ_IO_UNITS_RADIANS : in == PJ_IO_UNITS_CLASSIC)
+            return false;
+    }
+    if (!skip_finalize) {
+        if (out == PJ_IO_UNITS_CLASSIC)
+            return false;
+        if (out == PJ_IO_UNITS_RADIANS && (!fwd || Q->is_long_wrap_set))
+            return false;
+    }
+    return true;
+}
+
+/* Affine map of a step when the pipeline is run in the given direction */
+static bool get_step_affine(const Step &step, PJ_DIRECTION direction,
+                            double m[3][4]) {
+    const PJ *Q = step.pj;
+    if (step.omit_fwd || step.omit_inv || Q->get_affine == nullptr)
+        return false;
+    if (Q->inverted)
+        direction = direction == PJ_FWD ? PJ_INV : PJ_FWD;
+    return step_io_is_neutral(Q, direction) &&
+           Q->get_affine(Q, direction, m);
+}
+
+/* +proj=cart +inv followed by +proj=cart on the same ellipsoid, i.e. a */
+/* geocentric -> geographic -> geocentric round trip                     */
+static bool is_cart_round_trip(const Step &first, const Step &second) {
+    const PJ *A = first.pj;
+    const PJ *B = second.pj;
+    if (first.omit_fwd || first.omit_inv || second.omit_fwd ||
+        second.omit_inv)
+        return false;
+    if (strcmp(A->short_name, "cart") != 0 ||
+        strcmp(B->short_name, "cart") != 0 || !A->inverted || B->inverted)
+        return false;
+    if (A->a != B->a || A->es != B->es)
+        return false;
+    for (const PJ *Q : {A, B}) {
+        if (Q->axisswap || Q->cart || Q->cart_wgs84 || Q->helmert ||
+            Q->hgridshift || Q->vgridshift || Q->geoc ||
+            Q->to_meter != 1 || Q->fr_meter != 1)
+            return false;
+    }
+    return A->lam0 == B->lam0 && A->from_greenwich == B->from_greenwich;
+}
+
+/* m = m o first */
+static void compose_affine(double m[3][4], const double first[3][4]) {
+    double res[3][4];
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+            res[i][j] = m[i][0] * first[0][j] + m[i][1] * first[1][j] +
+                        m[i][2] * first[2][j];
+        }
+        res[i][3] += m[i][3];
+    }
+    memcpy(m, res, sizeof(res));
+}
+
+/* Peephole pass over the steps: find runs of at least two steps that are  */
+/* affine maps of x, y, z, or cancelling cart round trips, and replace    */
+/* them at run time by a single matrix product in each direction.         */
+static void fuse_steps(Pipeline *pipeline) {
+    auto &steps = pipeline->steps;
+    size_t i = 0;
+    while (i < steps.size()) {
+        FusedRun run;
+        run.first = i;
+        size_t j = i;
+        while (j < steps.size()) {
+            double fwd[3][4];
+            double inv[3][4];
+            if (j + 1 < steps.size() &&
+                is_cart_round_trip(steps[j], steps[j + 1])) {
+                j += 2;
+                continue;
+            }
+            if (!get_step_affine(steps[j], PJ_FWD, fwd) ||
+                !get_step_affine(steps[j], PJ_INV, inv))
+                break;
+            compose_affine(fwd, run.fwd);
+            memcpy(run.fwd, fwd, sizeof(fwd));
+            compose_affine(run.inv, inv);
+            j++;
+        }
+        if (j - i >= 2) {
+            run.last = j - 1;
+            for (size_t k = run.first; k <= run.last; k++)
+                steps[k].fused_run =
+                    static_cast<int>(pipeline->fused_runs.size());
+            pipeline->fused_runs.push_back(run);
+        }
+        i = std::max(j, i + 1);
+    }
+}
+
 PJ *OPERATION(pipeline, 0) {
     int i, nsteps = 0, argc;
     int i_pipeline = -1, i_first_step = -1, i_current_step;
@@ -381,6 +622,8 @@ PJ *OPERATION(pipeline, 0) {
 
     P->fwd4d = pipeline_forward_4d;
     P->inv4d = pipeline_reverse_4d;
+    P->fwd4d_batch = pipeline_forward_4d_batch;
+    P->inv4d_batch = pipeline_reverse_4d_batch;
     P->fwd3d = pipeline_forward_3d;
     P->inv3d = pipeline_reverse_3d;
     P->fwd = pipeline_forward;
@@ -555,6 +798,17 @@ PJ *OPERATION(pipeline, 0) {
         }
     }
 
+    /* push and pop exchange values between steps through the pipeline stack, */
+    /* which only works if the steps are run point by point                  */
+    for (auto &step : pipeline->steps) {
+        PJ *Q = step.pj;
+        if (Q->fwd4d == push || Q->fwd4d == pop) {
+            P->fwd4d_batch = nullptr;
+            P->inv4d_batch = nullptr;
+            break;
+        }
+    }
+
     /* determine if an inverse operation is possible */
     for (auto &step : pipeline->steps) {
         PJ *Q = step.pj;
@@ -564,6 +818,7 @@ PJ *OPERATION(pipeline, 0) {
             P->inv = nullptr;
             P->inv3d = nullptr;
             P->inv4d = nullptr;
+            P->inv4d_batch = nullptr;
             break;
         }
     }
@@ -635,6 +890,9 @@ PJ *OPERATION(pipeline, 0) {
     /* Now, correspondingly determine forward output (= reverse input) data type
      */
     P->right = pj_right(pipeline->steps.back().pj);
+
+    fuse_steps(pipeline);
+
     return P;
 }
 
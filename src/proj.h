@@ -203,6 +203,9 @@ typedef union PJ_COORD PJ_COORD;
 struct PJ_AREA;
 typedef struct PJ_AREA PJ_AREA;
 
+struct PJ_TRANS_APPROX;
+typedef struct PJ_TRANS_APPROX PJ_TRANS_APPROX;
+
 struct P5_FACTORS {          /* Common designation */
     double meridional_scale; /* h */
     double parallel_scale;   /* k */
@@ -418,6 +421,7 @@ void PROJ_DLL proj_context_set_search_paths(PJ_CONTEXT *ctx, int count_paths,
 void PROJ_DLL proj_context_set_ca_bundle_path(PJ_CONTEXT *ctx,
                                               const char *path);
 /*! @cond Doxygen_Suppress */
+void PROJ_DLL proj_context_set_num_threads(PJ_CONTEXT *ctx, int num_threads);
 void PROJ_DLL proj_context_use_proj4_init_rules(PJ_CONTEXT *ctx, int enable);
 int PROJ_DLL proj_context_get_use_proj4_init_rules(PJ_CONTEXT *ctx,
                                                    int from_legacy_code_path);
@@ -587,6 +591,19 @@ int PROJ_DLL proj_download_file(PJ_CONTEXT *ctx, const char *url_or_filename,
                                                     void *user_data),
                                 void *user_data);
 
+int PROJ_DLL proj_prefetch_grids_for_extent(PJ_CONTEXT *ctx, const PJ *P,
+                                            double west_lon_degree,
+                                            double south_lat_degree,
+                                            double east_lon_degree,
+                                            double north_lat_degree);
+
+void PROJ_DLL proj_crs_to_crs_cache_set_enable(PJ_CONTEXT *ctx, int enabled);
+
+void PROJ_DLL proj_crs_to_crs_cache_set_filename(PJ_CONTEXT *ctx,
+                                                 const char *fullname);
+
+void PROJ_DLL proj_crs_to_crs_cache_clear(PJ_CONTEXT *ctx);
+
 /*! @cond Doxygen_Suppress */
 
 /* Manage the transformation definition object PJ */
@@ -634,6 +651,8 @@ size_t PROJ_DLL proj_trans_generic(PJ *P, PJ_DIRECTION direction, double *x,
                                    size_t sx, size_t nx, double *y, size_t sy,
                                    size_t ny, double *z, size_t sz, size_t nz,
                                    double *t, size_t st, size_t nt);
+int PROJ_DLL proj_trans_soa(PJ *P, PJ_DIRECTION direction, size_t n, double *x,
+                            double *y, double *z, double *t, int *errors);
 /*! @endcond */
 int PROJ_DLL proj_trans_bounds(PJ_CONTEXT *context, PJ *P,
                                PJ_DIRECTION direction, double xmin, double ymin,
@@ -650,6 +669,14 @@ int PROJ_DLL proj_trans_bounds_3D(PJ_CONTEXT *context, PJ *P,
                                   double *out_xmax, double *out_ymax,
                                   double *out_zmax, const int densify_pts);
 
+PJ_TRANS_APPROX PROJ_DLL *
+proj_trans_approx_create(PJ_CONTEXT *ctx, PJ *P, PJ_DIRECTION direction,
+                         double xmin, double ymin, double xmax, double ymax,
+                         double max_error);
+int PROJ_DLL proj_trans_approx_array(PJ_TRANS_APPROX *approx, size_t n,
+                                     PJ_COORD *coord);
+void PROJ_DLL proj_trans_approx_destroy(PJ_TRANS_APPROX *approx);
+
 /*! @cond Doxygen_Suppress */
 
 /* Initializers */
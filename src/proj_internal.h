@@ -76,7 +76,9 @@
 #include "proj/common.hpp"
 #include "proj/coordinateoperation.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -216,6 +218,9 @@ proj_context_delete_cpp_context(struct projCppContext *cppContext);
 bool pj_fwd4d(PJ_COORD &coo, PJ *P);
 bool pj_inv4d(PJ_COORD &coo, PJ *P);
 
+void pj_fwd4d_batch(PJ_COORD *coo, size_t n, int *errors, PJ *P);
+void pj_inv4d_batch(PJ_COORD *coo, size_t n, int *errors, PJ *P);
+
 PJ_COORD PROJ_DLL pj_approx_2D_trans(PJ *P, PJ_DIRECTION direction,
                                      PJ_COORD coo);
 PJ_COORD PROJ_DLL pj_approx_3D_trans(PJ *P, PJ_DIRECTION direction,
@@ -303,10 +308,21 @@ PJ_OPERATOR:
     A function taking a reference to a PJ_COORD and a pointer-to-PJ as args,
 applying the PJ to the PJ_COORD, and modifying in-place the passed PJ_COORD.
 
+PJ_BATCH_OPERATOR:
+
+    A function taking a pointer to an array of PJ_COORD, its length, a
+pointer to an array of per-point error codes and a pointer-to-PJ as args,
+applying the PJ to all the coordinates in-place. Points whose first component
+is HUGE_VAL on input have already failed and must be left untouched. Points
+that fail to transform are set to HUGE_VAL, and their error code is stored in
+the corresponding element of the error array. Other elements of the error
+array are left untouched.
+
 *****************************************************************************/
 typedef PJ *(*PJ_CONSTRUCTOR)(PJ *);
 typedef PJ *(*PJ_DESTRUCTOR)(PJ *, int);
 typedef void (*PJ_OPERATOR)(PJ_COORD &, PJ *);
+typedef void (*PJ_BATCH_OPERATOR)(PJ_COORD *, size_t, int *, PJ *);
 /****************************************************************************/
 
 /* datum_type values */
@@ -395,7 +411,8 @@ struct PJCoordOperation {
           pjDstGeocentricToLonLat(
               other.pjDstGeocentricToLonLat
                   ? proj_clone(ctx, other.pjDstGeocentricToLonLat)
-                  : nullptr) {}
+                  : nullptr),
+          isInstantiableCached(other.isInstantiableCached) {}
 
     PJCoordOperation(PJCoordOperation &&other)
         : idxInOriginalList(other.idxInOriginalList), minxSrc(other.minxSrc),
@@ -417,6 +434,7 @@ struct PJCoordOperation {
         other.pjSrcGeocentricToLonLat = nullptr;
         pjDstGeocentricToLonLat = other.pjDstGeocentricToLonLat;
         other.pjDstGeocentricToLonLat = nullptr;
+        isInstantiableCached = other.isInstantiableCached;
     }
 
     PJCoordOperation &operator=(const PJCoordOperation &) = delete;
@@ -446,6 +464,56 @@ struct PJCoordOperation {
     mutable int isInstantiableCached = INSTANTIABLE_STATUS_UNKNOWN;
 };
 
+/* Uniform grid over the union of the bounding boxes of the areas of use of a
+ * list of PJCoordOperation, used to quickly find the operations that may apply
+ * to a coordinate. See pj_get_suggested_operation_indexed() in trans.cpp */
+struct PJCoordOperationIndex {
+    double minx = 0.0;
+    double miny = 0.0;
+    double maxx = 0.0;
+    double maxy = 0.0;
+    double invResX = 0.0;
+    double invResY = 0.0;
+    int nCols = 0;
+    int nRows = 0;
+
+    // Whether the x (resp. y) coordinate is a longitude in degree, that might
+    // need to be normalized to [-180,180] before comparing with bounding boxes
+    bool xIsLongitude = false;
+    bool yIsLongitude = false;
+
+    // Indices (in increasing order) of the operations whose bounding box
+    // intersects each cell
+    std::vector<std::vector<int>> cellCandidates{};
+
+    // Whether all candidate operations of a cell contain the whole cell
+    std::vector<bool> cellIsUniform{};
+
+    // For uniform cells, index of the selected operation, when
+    // skipNonInstantiable is false (resp. true). -2 if not computed yet
+    std::vector<int> cellBest[2]{};
+
+    int col(double x) const {
+        return std::min(nCols - 1, static_cast<int>((x - minx) * invResX));
+    }
+    int row(double y) const {
+        return std::min(nRows - 1, static_cast<int>((y - miny) * invResY));
+    }
+
+    // Returns the index of the cell of coord, or -1 if it is not covered by
+    // the index (all operations must then be considered)
+    int cell(const PJ_COORD &coord) const {
+        const double x = coord.xyzt.x;
+        const double y = coord.xyzt.y;
+        if (!(x >= minx && x <= maxx && y >= miny && y <= maxy))
+            return -1;
+        if ((xIsLongitude && !(x >= -180 && x <= 180)) ||
+            (yIsLongitude && !(y >= -180 && y <= 180)))
+            return -1;
+        return row(y) * nCols + col(x);
+    }
+};
+
 enum class TMercAlgo {
     AUTO, // Poder/Engsager if far from central meridian, otherwise
           // Evenden/Snyder
@@ -522,9 +590,21 @@ struct PJconsts {
     PJ_OPERATOR fwd4d = nullptr;
     PJ_OPERATOR inv4d = nullptr;
 
+    /* Optional batched versions of the point operators above, operating */
+    /* on contiguous blocks of coordinates. Only used when a point operator */
+    /* of the same direction is also set, and must give the same results */
+    PJ_BATCH_OPERATOR fwd4d_batch = nullptr;
+    PJ_BATCH_OPERATOR inv4d_batch = nullptr;
+
     PJ_DESTRUCTOR destructor = nullptr;
     void (*reassign_context)(PJ *, PJ_CONTEXT *) = nullptr;
 
+    /* Optional: if the forward (PJ_FWD) or inverse (PJ_INV) method is a */
+    /* time independent affine map of x, y, z, fill m so that the output */
+    /* is m[i][0] * x + m[i][1] * y + m[i][2] * z + m[i][3], and return   */
+    /* true. Used by the pipeline to fuse consecutive steps               */
+    bool (*get_affine)(const PJ *, PJ_DIRECTION, double m[3][4]) = nullptr;
+
     /*************************************************************************************
 
                           E L L I P S O I D     P A R A M E T E R S
@@ -665,6 +745,9 @@ struct PJconsts {
 
     NS_PROJ::util::BaseObjectPtr iso_obj{};
     bool iso_obj_is_coordinate_operation = false;
+    // PROJ string iso_obj has been instantiated from. Shared with clones, so
+    // that proj_clone() does not need to export iso_obj again.
+    std::shared_ptr<const std::string> iso_obj_proj_string{};
     double coordinateEpoch = 0;
     bool hasCoordinateEpoch = false;
 
@@ -682,6 +765,11 @@ struct PJconsts {
      proj_create_crs_to_crs() alternative coordinate operations
     **************************************************************************************/
     std::vector<PJCoordOperation> alternativeCoordinateOperations{};
+    // Spatial indices of alternativeCoordinateOperations for the forward and
+    // inverse directions. Built on first use by proj_trans()
+    bool alternativeCoordinateOperationsIndexBuilt = false;
+    std::unique_ptr<PJCoordOperationIndex>
+        alternativeCoordinateOperationsIndex[2]{};
     int iCurCoordOp = -1;
     bool errorIfBestTransformationNotAvailable = false;
     bool warnIfBestTransformationNotAvailable =
@@ -707,6 +795,7 @@ struct PJconsts {
 /* Parameter list (a copy of the +proj=... etc. parameters) */
 struct ARG_list {
     paralist *next;
+    size_t key_len; /* length of the name part of param, before any '=' */
     char used;
 #if (defined(__GNUC__) && __GNUC__ >= 8) ||                                    \
     (defined(__clang__) && __clang_major__ >= 9)
@@ -768,6 +857,11 @@ struct projGridChunkCache {
     int ttl = 86400; // 1 day
 };
 
+struct projCrsToCrsCache {
+    bool enabled = false;
+    std::string filename{};
+};
+
 struct projFileApiCallbackAndData {
     PROJ_FILE_HANDLE *(*open_cbk)(PJ_CONTEXT *ctx, const char *filename,
                                   PROJ_OPEN_ACCESS access,
@@ -837,10 +931,13 @@ struct PROJ_GCC_DLL pj_ctx {
     std::string ca_bundle_path{};
     bool native_ca = false;
     projGridChunkCache gridChunkCache{};
+    projCrsToCrsCache crsToCrsCache{};
     TMercAlgo defaultTmercAlgo =
         TMercAlgo::PODER_ENGSAGER; // can be overridden by content of proj.ini
     // END ini file settings
 
+    int num_threads = 1; // used by proj_trans_array() and similar functions
+
     int projStringParserCreateFromPROJStringRecursionCounter =
         0; // to avoid potential infinite recursion in
            // PROJStringParser::createFromPROJString()
@@ -992,6 +1089,12 @@ std::string PROJ_DLL pj_context_get_grid_cache_filename(PJ_CONTEXT *ctx);
 // For use by projsync
 std::string PROJ_DLL pj_get_relative_share_proj(PJ_CONTEXT *ctx);
 
+bool pj_context_get_crs_to_crs_cache_is_enabled(PJ_CONTEXT *ctx);
+std::string pj_context_get_crs_to_crs_cache_filename(PJ_CONTEXT *ctx);
+PJ *pj_crs_to_crs_cache_get(PJ_CONTEXT *ctx, const std::string &cacheKey);
+void pj_crs_to_crs_cache_put(PJ_CONTEXT *ctx, const std::string &cacheKey,
+                             const PJ *P);
+
 std::vector<PJCoordOperation>
 pj_create_prepared_operations(PJ_CONTEXT *ctx, const PJ *source_crs,
                               const PJ *target_crs, PJ_OBJ_LIST *op_list);
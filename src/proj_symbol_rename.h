@@ -59,6 +59,7 @@
 #define proj_context_set_fileapi internal_proj_context_set_fileapi
 #define proj_context_set_file_finder internal_proj_context_set_file_finder
 #define proj_context_set_network_callbacks internal_proj_context_set_network_callbacks
+#define proj_context_set_num_threads internal_proj_context_set_num_threads
 #define proj_context_set_search_paths internal_proj_context_set_search_paths
 #define proj_context_set_sqlite3_vfs_name internal_proj_context_set_sqlite3_vfs_name
 #define proj_context_set_url_endpoint internal_proj_context_set_url_endpoint
@@ -201,6 +202,9 @@
 #define proj_crs_info_list_destroy internal_proj_crs_info_list_destroy
 #define proj_crs_is_derived internal_proj_crs_is_derived
 #define proj_crs_promote_to_3D internal_proj_crs_promote_to_3D
+#define proj_crs_to_crs_cache_clear internal_proj_crs_to_crs_cache_clear
+#define proj_crs_to_crs_cache_set_enable internal_proj_crs_to_crs_cache_set_enable
+#define proj_crs_to_crs_cache_set_filename internal_proj_crs_to_crs_cache_set_filename
 #define proj_cs_get_axis_count internal_proj_cs_get_axis_count
 #define proj_cs_get_axis_info internal_proj_cs_get_axis_info
 #define proj_cs_get_type internal_proj_cs_get_type
@@ -294,6 +298,7 @@
 #define proj_operation_factory_context_set_spatial_criterion internal_proj_operation_factory_context_set_spatial_criterion
 #define proj_operation_factory_context_set_use_proj_alternative_grid_names internal_proj_operation_factory_context_set_use_proj_alternative_grid_names
 #define proj_pj_info internal_proj_pj_info
+#define proj_prefetch_grids_for_extent internal_proj_prefetch_grids_for_extent
 #define proj_prime_meridian_get_parameters internal_proj_prime_meridian_get_parameters
 #define proj_query_geodetic_crs_from_datum internal_proj_query_geodetic_crs_from_datum
 #define proj_roundtrip internal_proj_roundtrip
@@ -305,11 +310,15 @@
 #define proj_todeg internal_proj_todeg
 #define proj_torad internal_proj_torad
 #define proj_trans internal_proj_trans
+#define proj_trans_approx_array internal_proj_trans_approx_array
+#define proj_trans_approx_create internal_proj_trans_approx_create
+#define proj_trans_approx_destroy internal_proj_trans_approx_destroy
 #define proj_trans_array internal_proj_trans_array
 #define proj_trans_bounds internal_proj_trans_bounds
 #define proj_trans_bounds_3D internal_proj_trans_bounds_3D
 #define proj_trans_generic internal_proj_trans_generic
 #define proj_trans_get_last_used_operation internal_proj_trans_get_last_used_operation
+#define proj_trans_soa internal_proj_trans_soa
 #define proj_unit_list_destroy internal_proj_unit_list_destroy
 #define proj_uom_get_info_from_database internal_proj_uom_get_info_from_database
 #define proj_xy_dist internal_proj_xy_dist
@@ -507,6 +507,313 @@ static PJ_LP auto_e_inv(PJ_XY xy, PJ *P) {
         return approx_e_inv(xy, P);
 }
 
+/*****************************************************************************/
+//
+//                  Batch versions of the ellipsoidal functions
+//
+// Coordinates are processed TMERC_BATCH_LANES at a time: the transcendental
+// functions are evaluated point by point, while the arithmetic and the
+// Clenshaw summations are done lane-wise in fixed-length loops that the
+// compiler can vectorize. Operations are carried out in the same order as in
+// the point-wise functions above, so that both give the same results.
+//
+/*****************************************************************************/
+
+#define TMERC_BATCH_LANES 8
+
+/* pj_clenshaw() on TMERC_BATCH_LANES arguments */
+static void clenshaw_lanes(const double *szeta, const double *czeta,
+                           const double *F, int K, double *res) {
+    double X[TMERC_BATCH_LANES], u0[TMERC_BATCH_LANES], u1[TMERC_BATCH_LANES];
+    for (int j = 0; j < TMERC_BATCH_LANES; j++) {
+        X[j] = 2 * (czeta[j] - szeta[j]) * (czeta[j] + szeta[j]);
+        u0[j] = 0;
+        u1[j] = 0;
+    }
+    for (; K > 0;) {
+        const double f = F[--K];
+        for (int j = 0; j < TMERC_BATCH_LANES; j++) {
+            const double t = X[j] * u0[j] - u1[j] + f;
+            u1[j] = u0[j];
+            u0[j] = t;
+        }
+    }
+    for (int j = 0; j < TMERC_BATCH_LANES; j++)
+        res[j] = 2 * szeta[j] * czeta[j] * u0[j];
+}
+
+/* clenS() on TMERC_BATCH_LANES arguments, only returning the imaginary */
+/* part in I[] as the real part is added to Cn[] */
+static void clenS_lanes(const double *a, int size, const double *sin_arg_r,
+                        const double *cos_arg_r, const double *sinh_arg_i,
+                        const double *cosh_arg_i, double *Cn, double *I) {
+    double r[TMERC_BATCH_LANES], i[TMERC_BATCH_LANES];
+    double hr[TMERC_BATCH_LANES], hr1[TMERC_BATCH_LANES];
+    double hi[TMERC_BATCH_LANES], hi1[TMERC_BATCH_LANES];
+
+    const double *p = a + size;
+    const double last = *--p;
+    for (int j = 0; j < TMERC_BATCH_LANES; j++) {
+        r[j] = 2 * cos_arg_r[j] * cosh_arg_i[j];
+        i[j] = -2 * sin_arg_r[j] * sinh_arg_i[j];
+        hi1[j] = hr1[j] = hi[j] = 0;
+        hr[j] = last;
+    }
+
+    for (; a - p;) {
+        const double coef = *--p;
+        for (int j = 0; j < TMERC_BATCH_LANES; j++) {
+            const double hr2 = hr1[j];
+            const double hi2 = hi1[j];
+            hr1[j] = hr[j];
+            hi1[j] = hi[j];
+            hr[j] = -hr2 + r[j] * hr1[j] - i[j] * hi1[j] + coef;
+            hi[j] = -hi2 + i[j] * hr1[j] + r[j] * hi1[j];
+        }
+    }
+
+    for (int j = 0; j < TMERC_BATCH_LANES; j++) {
+        const double rr = sin_arg_r[j] * cosh_arg_i[j];
+        const double ii = cos_arg_r[j] * sinh_arg_i[j];
+        Cn[j] += rr * hr[j] - ii * hi[j];
+        I[j] = rr * hi[j] + ii * hr[j];
+    }
+}
+
+/* Gather up to TMERC_BATCH_LANES points not already failed, starting at */
+/* index i, into in0[] and in1[], padding unused lanes with zeros. Returns */
+/* the number of gathered points, and updates i */
+static int gather_lanes(const PJ_COORD *coo, size_t n, size_t &i,
+                        size_t *idx, double *in0, double *in1) {
+    int m = 0;
+    for (; i < n && m < TMERC_BATCH_LANES; i++) {
+        if (HUGE_VAL == coo[i].v[0])
+            continue;
+        idx[m] = i;
+        in0[m] = coo[i].v[0];
+        in1[m] = coo[i].v[1];
+        m++;
+    }
+    for (int j = m; j < TMERC_BATCH_LANES; j++)
+        in0[j] = in1[j] = 0;
+    return m;
+}
+
+/* Write back the results of the m first lanes. Lanes flagged in */
+/* outside[] are marked as failed */
+static void scatter_lanes(PJ_COORD *coo, int *errors, int m,
+                          const size_t *idx, const double *out0,
+                          const double *out1, const bool *outside) {
+    for (int j = 0; j < m; j++) {
+        PJ_COORD &c = coo[idx[j]];
+        if (outside[j]) {
+            c.v[0] = c.v[1] = HUGE_VAL;
+            errors[idx[j]] = PROJ_ERR_COORD_TRANSFM_OUTSIDE_PROJECTION_DOMAIN;
+        } else {
+            c.v[0] = out0[j];
+            c.v[1] = out1[j];
+        }
+    }
+}
+
+/* Ellipsoidal, forward, see exact_e_fwd() */
+static void exact_e_fwd_batch(PJ_COORD *coo, size_t n, int *errors, PJ *P) {
+    const auto *Q = &(static_cast<struct tmerc_data *>(P->opaque)->exact);
+    constexpr int L = TMERC_BATCH_LANES;
+    size_t idx[L];
+    double lam[L], phi[L], sin_phi[L], cos_phi[L], Cn[L];
+    double sin_Cn[L], cos_Cn[L], sin_Ce[L], cos_Ce[L], cos_Cn_cos_Ce[L];
+    double hyp[L], tan_Ce[L], Ce[L], sin_arg_r[L], cos_arg_r[L];
+    double sinh_arg_i[L], cosh_arg_i[L], dCe[L], x[L], y[L];
+    bool outside[L];
+
+    size_t i = 0;
+    while (i < n) {
+        const int m = gather_lanes(coo, n, i, idx, lam, phi);
+        if (m == 0)
+            break;
+
+        /* ell. LAT, LNG -> Gaussian LAT, LNG */
+        for (int j = 0; j < L; j++) {
+            sin_phi[j] = sin(phi[j]);
+            cos_phi[j] = cos(phi[j]);
+        }
+        clenshaw_lanes(sin_phi, cos_phi, Q->cbg, PROJ_ETMERC_ORDER, Cn);
+        for (int j = 0; j < L; j++)
+            Cn[j] = phi[j] + Cn[j];
+
+        /* Gaussian LAT, LNG -> compl. sph. LAT */
+        for (int j = 0; j < L; j++) {
+            sin_Cn[j] = sin(Cn[j]);
+            cos_Cn[j] = cos(Cn[j]);
+            sin_Ce[j] = sin(lam[j]);
+            cos_Ce[j] = cos(lam[j]);
+        }
+        for (int j = 0; j < L; j++)
+            cos_Cn_cos_Ce[j] = cos_Cn[j] * cos_Ce[j];
+        for (int j = 0; j < L; j++) {
+            Cn[j] = atan2(sin_Cn[j], cos_Cn_cos_Ce[j]);
+            hyp[j] = hypot(sin_Cn[j], cos_Cn_cos_Ce[j]);
+        }
+        for (int j = 0; j < L; j++) {
+            const double inv_denom_tan_Ce = 1. / hyp[j];
+            tan_Ce[j] = sin_Ce[j] * cos_Cn[j] * inv_denom_tan_Ce;
+
+            const double two_inv_denom_tan_Ce = 2 * inv_denom_tan_Ce;
+            const double two_inv_denom_tan_Ce_square =
+                two_inv_denom_tan_Ce * inv_denom_tan_Ce;
+            const double tmp_r =
+                cos_Cn_cos_Ce[j] * two_inv_denom_tan_Ce_square;
+            sin_arg_r[j] = sin_Cn[j] * tmp_r;
+            cos_arg_r[j] = cos_Cn_cos_Ce[j] * tmp_r - 1;
+            sinh_arg_i[j] = tan_Ce[j] * two_inv_denom_tan_Ce;
+            cosh_arg_i[j] = two_inv_denom_tan_Ce_square - 1;
+        }
+
+        /* compl. sph. N, E -> ell. norm. N, E */
+        for (int j = 0; j < L; j++)
+            Ce[j] = asinh(tan_Ce[j]);
+        clenS_lanes(Q->gtu, PROJ_ETMERC_ORDER, sin_arg_r, cos_arg_r,
+                    sinh_arg_i, cosh_arg_i, Cn, dCe);
+        for (int j = 0; j < L; j++) {
+            Ce[j] += dCe[j];
+            outside[j] = !(fabs(Ce[j]) <= 2.623395162778);
+            y[j] = Q->Qn * Cn[j] + Q->Zb; /* Northing */
+            x[j] = Q->Qn * Ce[j];         /* Easting  */
+        }
+
+        scatter_lanes(coo, errors, m, idx, x, y, outside);
+    }
+}
+
+/* Ellipsoidal, inverse, see exact_e_inv() */
+static void exact_e_inv_batch(PJ_COORD *coo, size_t n, int *errors, PJ *P) {
+    const auto *Q = &(static_cast<struct tmerc_data *>(P->opaque)->exact);
+    constexpr int L = TMERC_BATCH_LANES;
+    size_t idx[L];
+    double x[L], y[L], Cn[L], Ce[L], sin_arg_r[L], cos_arg_r[L];
+    double exp_2_Ce[L], sinh_arg_i[L], cosh_arg_i[L], dCe[L];
+    double sin_Cn[L], cos_Cn[L], sinhCe[L], modulus_Ce[L], rr[L];
+    double sin_chi[L], cos_chi[L], phi[L], lam[L];
+    bool outside[L];
+
+    size_t i = 0;
+    while (i < n) {
+        const int m = gather_lanes(coo, n, i, idx, x, y);
+        if (m == 0)
+            break;
+
+        /* normalize N, E */
+        for (int j = 0; j < L; j++) {
+            Cn[j] = (y[j] - Q->Zb) / Q->Qn;
+            Ce[j] = x[j] / Q->Qn;
+            outside[j] = !(fabs(Ce[j]) <= 2.623395162778); /* 150 degrees */
+            if (outside[j])
+                Cn[j] = Ce[j] = 0;
+        }
+
+        /* norm. N, E -> compl. sph. LAT, LNG */
+        for (int j = 0; j < L; j++) {
+            sin_arg_r[j] = sin(2 * Cn[j]);
+            cos_arg_r[j] = cos(2 * Cn[j]);
+            exp_2_Ce[j] = exp(2 * Ce[j]);
+        }
+        for (int j = 0; j < L; j++) {
+            const double half_inv_exp_2_Ce = 0.5 / exp_2_Ce[j];
+            sinh_arg_i[j] = 0.5 * exp_2_Ce[j] - half_inv_exp_2_Ce;
+            cosh_arg_i[j] = 0.5 * exp_2_Ce[j] + half_inv_exp_2_Ce;
+        }
+        clenS_lanes(Q->utg, PROJ_ETMERC_ORDER, sin_arg_r, cos_arg_r,
+                    sinh_arg_i, cosh_arg_i, Cn, dCe);
+        for (int j = 0; j < L; j++)
+            Ce[j] += dCe[j];
+
+        /* compl. sph. LAT -> Gaussian LAT, LNG */
+        for (int j = 0; j < L; j++) {
+            sin_Cn[j] = sin(Cn[j]);
+            cos_Cn[j] = cos(Cn[j]);
+            sinhCe[j] = sinh(Ce[j]);
+        }
+        for (int j = 0; j < L; j++) {
+            lam[j] = atan2(sinhCe[j], cos_Cn[j]);
+            modulus_Ce[j] = hypot(sinhCe[j], cos_Cn[j]);
+            rr[j] = hypot(sin_Cn[j], modulus_Ce[j]);
+            Cn[j] = atan2(sin_Cn[j], modulus_Ce[j]);
+        }
+
+        /* Gaussian LAT, LNG -> ell. LAT, LNG */
+        for (int j = 0; j < L; j++) {
+            sin_chi[j] = sin_Cn[j] / rr[j];
+            cos_chi[j] = modulus_Ce[j] / rr[j];
+        }
+        clenshaw_lanes(sin_chi, cos_chi, Q->cgb, PROJ_ETMERC_ORDER, phi);
+        for (int j = 0; j < L; j++)
+            phi[j] = Cn[j] + phi[j];
+
+        scatter_lanes(coo, errors, m, idx, lam, phi, outside);
+    }
+}
+
+/* Ellipsoidal, forward, see approx_e_fwd() */
+static void approx_e_fwd_batch(PJ_COORD *coo, size_t n, int *errors, PJ *P) {
+    const auto *Q = &(static_cast<struct tmerc_data *>(P->opaque)->approx);
+    constexpr int L = TMERC_BATCH_LANES;
+    size_t idx[L];
+    double lam[L], phi[L], sinphi[L], cosphi[L], al[L], sq[L], ml[L];
+    double x[L], y[L];
+    bool outside[L];
+
+    size_t i = 0;
+    while (i < n) {
+        const int m = gather_lanes(coo, n, i, idx, lam, phi);
+        if (m == 0)
+            break;
+
+        for (int j = 0; j < L; j++) {
+            outside[j] = lam[j] < -M_HALFPI || lam[j] > M_HALFPI;
+            sinphi[j] = sin(phi[j]);
+            cosphi[j] = cos(phi[j]);
+        }
+        for (int j = 0; j < L; j++) {
+            al[j] = cosphi[j] * lam[j];
+            sq[j] = 1. - P->es * sinphi[j] * sinphi[j];
+        }
+        for (int j = 0; j < L; j++)
+            sq[j] = sqrt(sq[j]);
+        clenshaw_lanes(sinphi, cosphi, Q->en + 1, int(AuxLat::ORDER), ml);
+
+        for (int j = 0; j < L; j++) {
+            double t = fabs(cosphi[j]) > 1e-10 ? sinphi[j] / cosphi[j] : 0.;
+            t *= t;
+            const double als = al[j] * al[j];
+            const double a = al[j] / sq[j];
+            const double nn = Q->esp * cosphi[j] * cosphi[j];
+            x[j] = P->k0 * a *
+                   (FC1 +
+                    FC3 * als *
+                        (1. - t + nn +
+                         FC5 * als *
+                             (5. + t * (t - 18.) + nn * (14. - 58. * t) +
+                              FC7 * als *
+                                  (61. + t * (t * (179. - t) - 479.)))));
+            y[j] = P->k0 *
+                   (Q->en[0] * (phi[j] + ml[j]) - Q->ml0 +
+                    sinphi[j] * a * lam[j] * FC2 *
+                        (1. +
+                         FC4 * als *
+                             (5. - t + nn * (9. + 4. * nn) +
+                              FC6 * als *
+                                  (61. + t * (t - 58.) +
+                                   nn * (270. - 330 * t) +
+                                   FC8 * als *
+                                       (1385. +
+                                        t * (t * (543. - t) - 3111.))))));
+        }
+
+        scatter_lanes(coo, errors, m, idx, x, y, outside);
+    }
+}
+
 static PJ *setup(PJ *P, TMercAlgo eAlg) {
 
     struct tmerc_data *Q =
@@ -529,6 +836,7 @@ static PJ *setup(PJ *P, TMercAlgo eAlg) {
         } else {
             P->inv = approx_e_inv;
             P->fwd = approx_e_fwd;
+            P->fwd4d_batch = approx_e_fwd_batch;
         }
         break;
     }
@@ -537,6 +845,8 @@ static PJ *setup(PJ *P, TMercAlgo eAlg) {
         setup_exact(P);
         P->inv = exact_e_inv;
         P->fwd = exact_e_fwd;
+        P->inv4d_batch = exact_e_inv_batch;
+        P->fwd4d_batch = exact_e_fwd_batch;
         break;
     }
 
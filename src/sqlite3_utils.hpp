@@ -105,6 +105,11 @@ class SQLiteStatement {
         iBindIdx++;
     }
 
+    void bindDouble(double v) {
+        sqlite3_bind_double(hStmt, iBindIdx, v);
+        iBindIdx++;
+    }
+
     void bindBlob(const void *blob, size_t blob_size) {
         sqlite3_bind_blob(hStmt, iBindIdx, blob, static_cast<int>(blob_size),
                           nullptr);
@@ -123,6 +128,17 @@ class SQLiteStatement {
         return ret;
     }
 
+    double getDouble() {
+        auto ret = sqlite3_column_double(hStmt, iResIdx);
+        iResIdx++;
+        return ret;
+    }
+
+    // Whether the next column to be fetched is NULL
+    bool isNull() const {
+        return sqlite3_column_type(hStmt, iResIdx) == SQLITE_NULL;
+    }
+
     const void *getBlob(int &size) {
         size = sqlite3_column_bytes(hStmt, iResIdx);
         auto ret = sqlite3_column_blob(hStmt, iResIdx);
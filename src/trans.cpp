@@ -1,7 +1,7 @@
 /******************************************************************************
  * Project:  PROJ
  * Purpose:  proj_trans(), proj_trans_array(), proj_trans_generic(),
- *proj_roundtrip()
+ *proj_trans_soa(), proj_roundtrip()
  *
  * Author:   Thomas Knudsen,  thokn@sdfe.dk,  2016-06-09/2016-11-06
  *
@@ -33,8 +33,12 @@
 #include "proj_internal.h"
 #include <math.h>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include "proj/internal/io_internal.hpp"
 
@@ -44,12 +48,15 @@ inline bool pj_coord_has_nans(PJ_COORD coo) {
 }
 
 /**************************************************************************************/
-int pj_get_suggested_operation(PJ_CONTEXT *,
-                               const std::vector<PJCoordOperation> &opList,
+static int pj_select_operation(const std::vector<PJCoordOperation> &opList,
+                               const std::vector<int> *candidates,
                                const int iExcluded[2], bool skipNonInstantiable,
                                PJ_DIRECTION direction, PJ_COORD coord)
 /**************************************************************************************/
 {
+    /* candidates, if not null, is the list, in increasing order, of the
+     * indices in opList of the operations that may match coord. Otherwise
+     * all operations are considered. */
     const auto normalizeLongitude = [](double x) {
         if (x > 180.0) {
             x -= 360.0;
@@ -67,8 +74,10 @@ int pj_get_suggested_operation(PJ_CONTEXT *,
     // and has the best accuracy.
     int iBest = -1;
     double bestAccuracy = std::numeric_limits<double>::max();
-    const int nOperations = static_cast<int>(opList.size());
-    for (int i = 0; i < nOperations; i++) {
+    const int nOperations = candidates ? static_cast<int>(candidates->size())
+                                       : static_cast<int>(opList.size());
+    for (int iCandidate = 0; iCandidate < nOperations; iCandidate++) {
+        const int i = candidates ? (*candidates)[iCandidate] : iCandidate;
         if (i == iExcluded[0] || i == iExcluded[1]) {
             continue;
         }
@@ -175,6 +184,189 @@ int pj_get_suggested_operation(PJ_CONTEXT *,
     return iBest;
 }
 
+/**************************************************************************************/
+int pj_get_suggested_operation(PJ_CONTEXT *,
+                               const std::vector<PJCoordOperation> &opList,
+                               const int iExcluded[2], bool skipNonInstantiable,
+                               PJ_DIRECTION direction, PJ_COORD coord)
+/**************************************************************************************/
+{
+    return pj_select_operation(opList, nullptr, iExcluded, skipNonInstantiable,
+                               direction, coord);
+}
+
+/**************************************************************************************/
+static std::unique_ptr<PJCoordOperationIndex>
+pj_create_operation_index(const std::vector<PJCoordOperation> &opList,
+                          PJ_DIRECTION direction)
+/**************************************************************************************/
+{
+    /* Build a uniform grid over the union of the bounding boxes of the
+     * operations (in the source CRS for the forward direction, in the target
+     * CRS for the inverse one). Returns null if the bounding boxes cannot be
+     * used for that, because they are expressed in a CRS different from the
+     * one of the coordinates (geocentric case) or are not finite.
+     * Operations with a world extent (see reproject_bbox()) are candidates of
+     * all cells, and operations with an empty extent of none. */
+    constexpr int GRID_SIZE = 32;
+
+    if (opList.size() < 2)
+        return nullptr;
+
+    struct BBox {
+        double minx, miny, maxx, maxy;
+        bool isWorld() const {
+            return minx == -std::numeric_limits<double>::max() &&
+                   miny == -std::numeric_limits<double>::max() &&
+                   maxx == std::numeric_limits<double>::max() &&
+                   maxy == std::numeric_limits<double>::max();
+        }
+        bool isEmpty() const { return !(minx <= maxx && miny <= maxy); }
+    };
+
+    std::unique_ptr<PJCoordOperationIndex> index(new PJCoordOperationIndex());
+    std::vector<BBox> bboxes;
+    bool first = true;
+    for (const auto &alt : opList) {
+        const bool fwd = direction == PJ_FWD;
+        if (fwd ? alt.pjSrcGeocentricToLonLat : alt.pjDstGeocentricToLonLat)
+            return nullptr;
+        BBox bbox;
+        bbox.minx = fwd ? alt.minxSrc : alt.minxDst;
+        bbox.miny = fwd ? alt.minySrc : alt.minyDst;
+        bbox.maxx = fwd ? alt.maxxSrc : alt.maxxDst;
+        bbox.maxy = fwd ? alt.maxySrc : alt.maxyDst;
+        if (!std::isfinite(bbox.minx) || !std::isfinite(bbox.miny) ||
+            !std::isfinite(bbox.maxx) || !std::isfinite(bbox.maxy)) {
+            return nullptr;
+        }
+        if (fwd ? alt.srcIsLonLatDegree : alt.dstIsLonLatDegree)
+            index->xIsLongitude = true;
+        if (fwd ? alt.srcIsLatLonDegree : alt.dstIsLatLonDegree)
+            index->yIsLongitude = true;
+        bboxes.push_back(bbox);
+        if (bbox.isWorld() || bbox.isEmpty())
+            continue;
+
+        if (first) {
+            index->minx = bbox.minx;
+            index->miny = bbox.miny;
+            index->maxx = bbox.maxx;
+            index->maxy = bbox.maxy;
+            first = false;
+        } else {
+            index->minx = std::min(index->minx, bbox.minx);
+            index->miny = std::min(index->miny, bbox.miny);
+            index->maxx = std::max(index->maxx, bbox.maxx);
+            index->maxy = std::max(index->maxy, bbox.maxy);
+        }
+    }
+    if (first || !std::isfinite(index->maxx - index->minx) ||
+        !std::isfinite(index->maxy - index->miny)) {
+        return nullptr;
+    }
+
+    const double resX = (index->maxx - index->minx) / GRID_SIZE;
+    const double resY = (index->maxy - index->miny) / GRID_SIZE;
+    index->nCols = resX > 0 ? GRID_SIZE : 1;
+    index->nRows = resY > 0 ? GRID_SIZE : 1;
+    index->invResX = resX > 0 ? 1.0 / resX : 0.0;
+    index->invResY = resY > 0 ? 1.0 / resY : 0.0;
+
+    const size_t nCells = static_cast<size_t>(index->nCols) * index->nRows;
+    index->cellCandidates.resize(nCells);
+    index->cellIsUniform.resize(nCells, true);
+    index->cellBest[0].resize(nCells, -2);
+    index->cellBest[1].resize(nCells, -2);
+
+    for (int i = 0; i < static_cast<int>(bboxes.size()); i++) {
+        const auto &bbox = bboxes[i];
+        if (bbox.isEmpty())
+            continue;
+        if (bbox.isWorld()) {
+            for (auto &candidates : index->cellCandidates)
+                candidates.push_back(i);
+            continue;
+        }
+        const int ixMin = index->col(bbox.minx);
+        const int ixMax = index->col(bbox.maxx);
+        const int iyMin = index->row(bbox.miny);
+        const int iyMax = index->row(bbox.maxy);
+        for (int iy = iyMin; iy <= iyMax; iy++) {
+            for (int ix = ixMin; ix <= ixMax; ix++) {
+                const size_t iCell =
+                    static_cast<size_t>(iy) * index->nCols + ix;
+                index->cellCandidates[iCell].push_back(i);
+
+                // Check if the bounding box contains all the points that
+                // are mapped to that cell, with some margin for rounding
+                // errors.
+                const double cellMinX =
+                    std::max(index->minx, index->minx + (ix - 1e-6) * resX);
+                const double cellMaxX =
+                    std::min(index->maxx, index->minx + (ix + 1 + 1e-6) * resX);
+                const double cellMinY =
+                    std::max(index->miny, index->miny + (iy - 1e-6) * resY);
+                const double cellMaxY =
+                    std::min(index->maxy, index->miny + (iy + 1 + 1e-6) * resY);
+                if (!(bbox.minx <= cellMinX && bbox.maxx >= cellMaxX &&
+                      bbox.miny <= cellMinY && bbox.maxy >= cellMaxY)) {
+                    index->cellIsUniform[iCell] = false;
+                }
+            }
+        }
+    }
+
+    return index;
+}
+
+/**************************************************************************************/
+static int pj_get_suggested_operation_indexed(PJ *P, const int iExcluded[2],
+                                              bool skipNonInstantiable,
+                                              PJ_DIRECTION direction,
+                                              PJ_COORD coord)
+/**************************************************************************************/
+{
+    /* Same as pj_get_suggested_operation(), but using a spatial index of the
+     * alternative coordinate operations of P, built on first use, to only
+     * evaluate the operations whose area of use may contain coord.
+     *
+     * In cells of the index where all candidate operations contain the whole
+     * cell, the result does not depend on the exact position of coord, and
+     * is cached, which makes spatially coherent streams of coordinates
+     * cheap. */
+    const auto &opList = P->alternativeCoordinateOperations;
+    if (!P->alternativeCoordinateOperationsIndexBuilt) {
+        P->alternativeCoordinateOperationsIndex[0] =
+            pj_create_operation_index(opList, PJ_FWD);
+        P->alternativeCoordinateOperationsIndex[1] =
+            pj_create_operation_index(opList, PJ_INV);
+        P->alternativeCoordinateOperationsIndexBuilt = true;
+    }
+
+    auto index =
+        P->alternativeCoordinateOperationsIndex[direction == PJ_FWD ? 0 : 1]
+            .get();
+    const int iCell = index ? index->cell(coord) : -1;
+    if (iCell < 0) {
+        return pj_select_operation(opList, nullptr, iExcluded,
+                                   skipNonInstantiable, direction, coord);
+    }
+
+    const auto &candidates = index->cellCandidates[iCell];
+    if (iExcluded[0] < 0 && iExcluded[1] < 0 && index->cellIsUniform[iCell]) {
+        int &cachedBest = index->cellBest[skipNonInstantiable ? 1 : 0][iCell];
+        if (cachedBest == -2) {
+            cachedBest =
+                pj_select_operation(opList, &candidates, iExcluded,
+                                    skipNonInstantiable, direction, coord);
+        }
+        return cachedBest;
+    }
+    return pj_select_operation(opList, &candidates, iExcluded,
+                               skipNonInstantiable, direction, coord);
+}
+
 /**************************************************************************************/
 void pj_warn_about_missing_grid(PJ *P)
 /**************************************************************************************/
@@ -248,9 +440,8 @@ PJ_COORD proj_trans(PJ *P, PJ_DIRECTION direction, PJ_COORD coord) {
         for (int iRetry = 0; iRetry <= N_MAX_RETRY; iRetry++) {
             // Do a first pass and select the operations that match the area of
             // use and has the best accuracy.
-            int iBest = pj_get_suggested_operation(
-                P->ctx, P->alternativeCoordinateOperations, iExcluded,
-                skipNonInstantiable, direction, coord);
+            int iBest = pj_get_suggested_operation_indexed(
+                P, iExcluded, skipNonInstantiable, direction, coord);
             if (iBest < 0) {
                 break;
             }
@@ -376,6 +567,168 @@ object must be freed with proj_destroy().
                       P->alternativeCoordinateOperations[P->iCurCoordOp].pj);
 }
 
+/* Number of coordinates transformed at once by the batched code paths. */
+/* Small enough for a block to stay in cache while it travels through all */
+/* the steps of a pipeline.                                               */
+constexpr size_t PJ_BATCH_CHUNK_SIZE = 256;
+
+/* Minimum number of coordinates handled by each worker thread, so that the */
+/* cost of cloning the transformation for the thread is amortized.          */
+constexpr size_t PJ_MIN_COORDS_PER_THREAD = 65536;
+
+/*****************************************************************************/
+static void pj_trans_batch(PJ *P, PJ_DIRECTION direction, size_t n,
+                           PJ_COORD *coord, int *errors) {
+    /******************************************************************************
+        Transform n coordinates in place, storing the error code of each point
+        in errors[] (0 on success).
+
+        Objects with alternative coordinate operations go through proj_trans()
+        point by point. Other objects are transformed block-wise through
+        pj_fwd4d_batch()/pj_inv4d_batch(), except for the points that
+        proj_trans() treats specially (NaN or HUGE_VAL input).
+    ******************************************************************************/
+    if (P->iso_obj != nullptr && !P->iso_obj_is_coordinate_operation) {
+        pj_log(P->ctx, PJ_LOG_ERROR, "Object is not a coordinate operation");
+        for (size_t i = 0; i < n; i++) {
+            coord[i] = proj_coord_error();
+            errors[i] = PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE;
+        }
+        return;
+    }
+
+    if (!P->alternativeCoordinateOperations.empty()) {
+        for (size_t i = 0; i < n; i++) {
+            proj_context_errno_set(P->ctx, 0);
+            coord[i] = proj_trans(P, direction, coord[i]);
+            errors[i] = proj_errno(P);
+        }
+        return;
+    }
+
+    const PJ_DIRECTION batchDirection =
+        P->inverted ? pj_opposite_direction(direction) : direction;
+    P->iCurCoordOp = 0;
+
+    size_t i = 0;
+    while (i < n) {
+        if (pj_coord_has_nans(coord[i]) || coord[i].v[0] == HUGE_VAL) {
+            proj_context_errno_set(P->ctx, 0);
+            coord[i] = proj_trans(P, direction, coord[i]);
+            errors[i] = proj_errno(P);
+            i++;
+            continue;
+        }
+
+        size_t j = i;
+        for (; j < n; j++) {
+            if (pj_coord_has_nans(coord[j]) || coord[j].v[0] == HUGE_VAL)
+                break;
+            if (P->hasCoordinateEpoch)
+                coord[j].xyzt.t = P->coordinateEpoch;
+            errors[j] = 0;
+        }
+
+        proj_context_errno_set(P->ctx, 0);
+        if (batchDirection == PJ_FWD)
+            pj_fwd4d_batch(coord + i, j - i, errors + i, P);
+        else
+            pj_inv4d_batch(coord + i, j - i, errors + i, P);
+        i = j;
+    }
+}
+
+/*****************************************************************************/
+static int pj_merge_errno(int retErrno, int thisErrno) {
+    /******************************************************************************
+        Combine the error code of a point (or of a set of points) with the
+        one of the points processed before: 0 if there was no error, the
+        precise error code if all failures are for the same reason, or
+        PROJ_ERR_COORD_TRANSFM otherwise.
+    ******************************************************************************/
+    if (thisErrno == 0 || thisErrno == retErrno)
+        return retErrno;
+    if (retErrno == 0)
+        return thisErrno;
+    return PROJ_ERR_COORD_TRANSFM;
+}
+
+/*****************************************************************************/
+template <class RangeFunc>
+static int pj_trans_split_over_threads(PJ *P, size_t n, RangeFunc rangeFunc) {
+    /******************************************************************************
+        Call rangeFunc(PJ *worker, size_t start, size_t count) on consecutive
+        ranges covering [0, n), and return the merged error codes returned
+        by rangeFunc.
+
+        If proj_context_set_num_threads() has been used on the context of P
+        and there are enough coordinates, the ranges are processed by several
+        threads. P is used by the calling thread, and each other thread uses
+        its own clone of P, attached to its own clone of the context of P, so
+        that no mutable state (grid caches, error codes, ...) is shared.
+        If P cannot be cloned, everything is processed by the calling thread.
+    ******************************************************************************/
+    size_t nThreads = 1;
+    int requestedThreads = P->ctx->num_threads;
+    if (requestedThreads < 0)
+        requestedThreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (requestedThreads > 1) {
+        nThreads = std::min(static_cast<size_t>(requestedThreads),
+                            n / PJ_MIN_COORDS_PER_THREAD);
+    }
+    if (nThreads <= 1)
+        return rangeFunc(P, 0, n);
+
+    std::vector<PJ_CONTEXT *> workerContexts;
+    std::vector<PJ *> workers;
+    for (size_t i = 1; i < nThreads; i++) {
+        PJ_CONTEXT *workerCtx = proj_context_clone(P->ctx);
+        if (workerCtx == nullptr)
+            break;
+        PJ *worker = proj_clone(workerCtx, P);
+        if (worker == nullptr || worker->inverted != P->inverted) {
+            proj_destroy(worker);
+            proj_context_destroy(workerCtx);
+            break;
+        }
+        workerContexts.push_back(workerCtx);
+        workers.push_back(worker);
+    }
+    nThreads = workers.size() + 1;
+
+    const size_t countPerThread = n / nThreads;
+    std::vector<int> rangeErrnos(nThreads, 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nThreads; i++) {
+        const size_t start = i * countPerThread;
+        const size_t count =
+            (i + 1 == nThreads) ? n - start : countPerThread;
+        PJ *worker = workers[i - 1];
+        int *pErrno = &rangeErrnos[i];
+        try {
+            threads.emplace_back([&rangeFunc, worker, start, count, pErrno]() {
+                *pErrno = rangeFunc(worker, start, count);
+            });
+        } catch (const std::exception &) {
+            // Thread creation failed: process the range here
+            *pErrno = rangeFunc(worker, start, count);
+        }
+    }
+    rangeErrnos[0] = rangeFunc(P, 0, countPerThread);
+    for (auto &thread : threads)
+        thread.join();
+
+    for (size_t i = 0; i < workers.size(); i++) {
+        proj_destroy(workers[i]);
+        proj_context_destroy(workerContexts[i]);
+    }
+
+    int retErrno = 0;
+    for (int rangeErrno : rangeErrnos)
+        retErrno = pj_merge_errno(retErrno, rangeErrno);
+    return retErrno;
+}
+
 /*****************************************************************************/
 int proj_trans_array(PJ *P, PJ_DIRECTION direction, size_t n, PJ_COORD *coord) {
     /******************************************************************************
@@ -392,31 +745,39 @@ int proj_trans_array(PJ *P, PJ_DIRECTION direction, size_t n, PJ_COORD *coord) {
         for the same reason, or a generic error code if they fail for different
         reasons.
     ******************************************************************************/
-    size_t i;
-    int retErrno = 0;
-    bool hasSetRetErrno = false;
-    bool sameRetErrno = true;
+    if (nullptr == P)
+        return 0;
 
-    for (i = 0; i < n; i++) {
-        proj_context_errno_set(P->ctx, 0);
-        coord[i] = proj_trans(P, direction, coord[i]);
-        int thisErrno = proj_errno(P);
-        if (thisErrno != 0) {
-            if (!hasSetRetErrno) {
-                retErrno = thisErrno;
-                hasSetRetErrno = true;
-            } else if (sameRetErrno && retErrno != thisErrno) {
-                sameRetErrno = false;
-                retErrno = PROJ_ERR_COORD_TRANSFM;
+    if (direction == PJ_IDENT)
+        return 0;
+
+    const int retErrno = pj_trans_split_over_threads(
+        P, n, [direction, coord](PJ *worker, size_t start, size_t count) {
+            int rangeErrno = 0;
+            int errors[PJ_BATCH_CHUNK_SIZE];
+            for (size_t iChunk = start; iChunk < start + count;
+                 iChunk += PJ_BATCH_CHUNK_SIZE) {
+                const size_t nChunk =
+                    std::min(PJ_BATCH_CHUNK_SIZE, start + count - iChunk);
+                pj_trans_batch(worker, direction, nChunk, coord + iChunk,
+                               errors);
+                for (size_t i = 0; i < nChunk; i++)
+                    rangeErrno = pj_merge_errno(rangeErrno, errors[i]);
             }
-        }
-    }
+            return rangeErrno;
+        });
 
     proj_context_errno_set(P->ctx, retErrno);
 
     return retErrno;
 }
 
+static inline double *pj_advance_double_ptr(double *ptr, size_t bytes) {
+    /* The casts are somewhat funky, but they compile down to no-ops and  */
+    /* they tell compilers and static analyzers that we know what we do   */
+    return reinterpret_cast<double *>(reinterpret_cast<char *>(ptr) + bytes);
+}
+
 /*************************************************************************************/
 size_t proj_trans_generic(PJ *P, PJ_DIRECTION direction, double *x, size_t sx,
                           size_t nx, double *y, size_t sy, size_t ny, double *z,
@@ -473,7 +834,7 @@ size_t proj_trans_generic(PJ *P, PJ_DIRECTION direction, double *x, size_t sx,
 
     **************************************************************************************/
     PJ_COORD coord = {{0, 0, 0, 0}};
-    size_t i, nmin;
+    size_t nmin;
     double null_broadcast = 0;
     double invalid_time = HUGE_VAL;
 
@@ -538,35 +899,70 @@ size_t proj_trans_generic(PJ *P, PJ_DIRECTION direction, double *x, size_t sx,
     /* Arrays of length >1 are iterated over (for the first nmin values) */
     /* The slightly convolved incremental indexing is used due           */
     /* to the stride, which may be any size supported by the platform    */
-    for (i = 0; i < nmin; i++) {
-        coord.xyzt.x = *x;
-        coord.xyzt.y = *y;
-        coord.xyzt.z = *z;
-        coord.xyzt.t = *t;
-
-        coord = proj_trans(P, direction, coord);
-
-        /* in all full length cases, we overwrite the input with the output,  */
-        /* and step on to the next element.                                   */
-        /* The casts are somewhat funky, but they compile down to no-ops and  */
-        /* they tell compilers and static analyzers that we know what we do   */
-        if (nx > 1) {
-            *x = coord.xyzt.x;
-            x = reinterpret_cast<double *>((reinterpret_cast<char *>(x) + sx));
-        }
-        if (ny > 1) {
-            *y = coord.xyzt.y;
-            y = reinterpret_cast<double *>((reinterpret_cast<char *>(y) + sy));
-        }
-        if (nz > 1) {
-            *z = coord.xyzt.z;
-            z = reinterpret_cast<double *>((reinterpret_cast<char *>(z) + sz));
-        }
-        if (nt > 1) {
-            *t = coord.xyzt.t;
-            t = reinterpret_cast<double *>((reinterpret_cast<char *>(t) + st));
+    /* Coordinates are gathered in blocks of PJ_BATCH_CHUNK_SIZE, which  */
+    /* are transformed at once, and then scattered back.                 */
+    pj_trans_split_over_threads(P, nmin, [&](PJ *worker, size_t start,
+                                             size_t count) {
+        double *xRange = (nx > 1) ? pj_advance_double_ptr(x, start * sx) : x;
+        double *yRange = (ny > 1) ? pj_advance_double_ptr(y, start * sy) : y;
+        double *zRange = (nz > 1) ? pj_advance_double_ptr(z, start * sz) : z;
+        double *tRange = (nt > 1) ? pj_advance_double_ptr(t, start * st) : t;
+
+        PJ_COORD chunk[PJ_BATCH_CHUNK_SIZE];
+        int errors[PJ_BATCH_CHUNK_SIZE];
+        for (size_t i = 0; i < count;) {
+            const size_t nChunk = std::min(PJ_BATCH_CHUNK_SIZE, count - i);
+
+            double *xIter = xRange;
+            double *yIter = yRange;
+            double *zIter = zRange;
+            double *tIter = tRange;
+            for (size_t j = 0; j < nChunk; j++) {
+                chunk[j].xyzt.x = *xIter;
+                chunk[j].xyzt.y = *yIter;
+                chunk[j].xyzt.z = *zIter;
+                chunk[j].xyzt.t = *tIter;
+                if (nx > 1)
+                    xIter = pj_advance_double_ptr(xIter, sx);
+                if (ny > 1)
+                    yIter = pj_advance_double_ptr(yIter, sy);
+                if (nz > 1)
+                    zIter = pj_advance_double_ptr(zIter, sz);
+                if (nt > 1)
+                    tIter = pj_advance_double_ptr(tIter, st);
+            }
+
+            pj_trans_batch(worker, direction, nChunk, chunk, errors);
+
+            /* in all full length cases, we overwrite the input with the */
+            /* output, and step on to the next element.                  */
+            for (size_t j = 0; j < nChunk; j++) {
+                if (nx > 1) {
+                    *xRange = chunk[j].xyzt.x;
+                    xRange = pj_advance_double_ptr(xRange, sx);
+                }
+                if (ny > 1) {
+                    *yRange = chunk[j].xyzt.y;
+                    yRange = pj_advance_double_ptr(yRange, sy);
+                }
+                if (nz > 1) {
+                    *zRange = chunk[j].xyzt.z;
+                    zRange = pj_advance_double_ptr(zRange, sz);
+                }
+                if (nt > 1) {
+                    *tRange = chunk[j].xyzt.t;
+                    tRange = pj_advance_double_ptr(tRange, st);
+                }
+            }
+
+            i += nChunk;
+            /* Only the range holding the last point updates the broadcast */
+            /* value                                                       */
+            if (start + i == nmin)
+                coord = chunk[nChunk - 1];
         }
-    }
+        return 0;
+    });
 
     /* Last time around, we update the length 1 cases with their transformed
      * alter egos */
@@ -579,7 +975,79 @@ size_t proj_trans_generic(PJ *P, PJ_DIRECTION direction, double *x, size_t sx,
     if (nt == 1)
         *t = coord.xyzt.t;
 
-    return i;
+    return nmin;
+}
+
+/*****************************************************************************/
+int proj_trans_soa(PJ *P, PJ_DIRECTION direction, size_t n, double *x,
+                   double *y, double *z, double *t, int *errors) {
+    /******************************************************************************
+        Batch transform coordinates stored as separate x, y, z and t arrays
+        ("structure of arrays" layout), each of them holding n values.
+
+        z and t may be null pointers, in which case they are treated as
+        arrays of zeroes, respectively of unknown times (HUGE_VAL), and are
+        not written to.
+
+        errors may be a null pointer. Otherwise it must point to an array
+        of n values, where the error code of each individual point is stored
+        (0 if the point was successfully transformed).
+
+        Individual points that fail to transform will have their components
+        set to HUGE_VAL.
+
+        The return value has the same meaning as for proj_trans_array().
+    ******************************************************************************/
+    if (nullptr == P)
+        return 0;
+
+    if (nullptr == x || nullptr == y) {
+        proj_log_error(P, _("x and y arrays must be provided"));
+        proj_errno_set(P, PROJ_ERR_OTHER_API_MISUSE);
+        return PROJ_ERR_OTHER_API_MISUSE;
+    }
+
+    if (direction == PJ_IDENT) {
+        if (errors)
+            std::fill(errors, errors + n, 0);
+        return 0;
+    }
+
+    const int retErrno = pj_trans_split_over_threads(
+        P, n, [=](PJ *worker, size_t start, size_t count) {
+            int rangeErrno = 0;
+            PJ_COORD chunk[PJ_BATCH_CHUNK_SIZE];
+            int chunkErrors[PJ_BATCH_CHUNK_SIZE];
+            for (size_t iChunk = start; iChunk < start + count;
+                 iChunk += PJ_BATCH_CHUNK_SIZE) {
+                const size_t nChunk =
+                    std::min(PJ_BATCH_CHUNK_SIZE, start + count - iChunk);
+                for (size_t i = 0; i < nChunk; i++) {
+                    chunk[i].xyzt.x = x[iChunk + i];
+                    chunk[i].xyzt.y = y[iChunk + i];
+                    chunk[i].xyzt.z = z ? z[iChunk + i] : 0.0;
+                    chunk[i].xyzt.t = t ? t[iChunk + i] : HUGE_VAL;
+                }
+
+                int *pErrors = errors ? errors + iChunk : chunkErrors;
+                pj_trans_batch(worker, direction, nChunk, chunk, pErrors);
+
+                for (size_t i = 0; i < nChunk; i++) {
+                    x[iChunk + i] = chunk[i].xyzt.x;
+                    y[iChunk + i] = chunk[i].xyzt.y;
+                    if (z)
+                        z[iChunk + i] = chunk[i].xyzt.z;
+                    if (t)
+                        t[iChunk + i] = chunk[i].xyzt.t;
+                    rangeErrno = pj_merge_errno(rangeErrno, pErrors[i]);
+                }
+            }
+            return rangeErrno;
+        });
+
+    proj_context_errno_set(P->ctx, retErrno);
+
+    return retErrno;
 }
 
 static bool inline coord_is_all_nans(PJ_COORD coo) {
@@ -0,0 +1,411 @@
+/******************************************************************************
+ * Project:  PROJ
+ * Purpose:  Implements proj_trans_approx_create() and related functions
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, PROJ contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+#define FROM_PROJ_CPP
+
+#include "proj.h"
+#include "proj_internal.h"
+#include <math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/* Cells of the extent are subdivided down to 1/2^APPROX_MAX_DEPTH of its */
+/* size. Cells that are still not accurate enough at that depth are      */
+/* transformed exactly.                                                  */
+#define APPROX_MAX_DEPTH 8
+
+/* Cells are always subdivided down to that depth, so that features much */
+/* smaller than the extent are not missed by the check points            */
+#define APPROX_MIN_DEPTH 2
+
+/* Number of check points in a cell */
+#define APPROX_CHECK_POINTS 9
+
+namespace { // anonymous namespace
+
+// Position of the check points in a cell, as fractions of its width and
+// height: the centre, the middle of the edges, and the centres of the
+// quadrants. The first 5 ones are the corners of the children of the cell.
+constexpr double checkU[APPROX_CHECK_POINTS] = {0.5,  0.5,  0,    1,   0.5,
+                                                0.25, 0.75, 0.25, 0.75};
+constexpr double checkV[APPROX_CHECK_POINTS] = {0.5,  0,    0.5,  0.5, 1,
+                                                0.25, 0.25, 0.75, 0.75};
+
+struct ApproxCell {
+    double xmin = 0;
+    double ymin = 0;
+    double xmax = 0;
+    double ymax = 0;
+    // Index of the first of the 4 children (south-west, south-east,
+    // north-west, north-east) in PJ_TRANS_APPROX::cells, or -1 for a leaf
+    int firstChild = -1;
+    // Whether the points of that leaf must be transformed exactly
+    bool exact = false;
+    // Transformed south-west, south-east, north-west and north-east corners
+    PJ_COORD corners[4] = {};
+};
+
+} // anonymous namespace
+
+struct PJ_TRANS_APPROX {
+    PJ *P = nullptr;
+    PJ_DIRECTION direction = PJ_FWD;
+    double maxError = 0;
+    std::vector<ApproxCell> cells{};
+    size_t lastLeaf = 0;
+};
+
+// ---------------------------------------------------------------------------
+
+static PJ_COORD approx_interpolate(const ApproxCell &cell, double x,
+                                   double y) {
+    const double u = (x - cell.xmin) / (cell.xmax - cell.xmin);
+    const double v = (y - cell.ymin) / (cell.ymax - cell.ymin);
+    const double w00 = (1 - u) * (1 - v);
+    const double w10 = u * (1 - v);
+    const double w01 = (1 - u) * v;
+    const double w11 = u * v;
+    PJ_COORD out;
+    for (int j = 0; j < 3; j++) {
+        out.v[j] = w00 * cell.corners[0].v[j] + w10 * cell.corners[1].v[j] +
+                   w01 * cell.corners[2].v[j] + w11 * cell.corners[3].v[j];
+    }
+    out.v[3] = HUGE_VAL;
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+
+static PJ_COORD approx_control_point(double x, double y) {
+    return proj_coord(x, y, 0, HUGE_VAL);
+}
+
+// ---------------------------------------------------------------------------
+
+static void approx_subdivide(PJ_TRANS_APPROX *approx) {
+    /* Build the tree of cells level by level, transforming the check points
+     * of all the cells of a level at once */
+    std::vector<size_t> pending{0};
+    std::vector<PJ_COORD> checks;
+    for (int depth = 0; !pending.empty(); depth++) {
+        checks.clear();
+        for (const size_t idx : pending) {
+            const auto &cell = approx->cells[idx];
+            for (int k = 0; k < APPROX_CHECK_POINTS; k++) {
+                checks.push_back(approx_control_point(
+                    cell.xmin + checkU[k] * (cell.xmax - cell.xmin),
+                    cell.ymin + checkV[k] * (cell.ymax - cell.ymin)));
+            }
+        }
+        std::vector<PJ_COORD> exact(checks);
+        proj_trans_array(approx->P, approx->direction, exact.size(),
+                         exact.data());
+
+        std::vector<size_t> next;
+        for (size_t i = 0; i < pending.size(); i++) {
+            const PJ_COORD *checksOfCell = &checks[i * APPROX_CHECK_POINTS];
+            const PJ_COORD *exactOfCell = &exact[i * APPROX_CHECK_POINTS];
+            auto *cell = &approx->cells[pending[i]];
+
+            int failures = 0;
+            for (const auto &corner : cell->corners) {
+                if (corner.v[0] == HUGE_VAL)
+                    failures++;
+            }
+            double error = 0;
+            for (int k = 0; k < APPROX_CHECK_POINTS; k++) {
+                if (exactOfCell[k].v[0] == HUGE_VAL) {
+                    failures++;
+                    continue;
+                }
+                const PJ_COORD interpolated = approx_interpolate(
+                    *cell, checksOfCell[k].v[0], checksOfCell[k].v[1]);
+                for (int j = 0; j < 3; j++) {
+                    error = std::max(error, fabs(interpolated.v[j] -
+                                                 exactOfCell[k].v[j]));
+                }
+            }
+            /* NaN errors must not be accepted */
+            if (failures == 0 && error <= approx->maxError &&
+                depth >= APPROX_MIN_DEPTH)
+                continue;
+            if (failures == 4 + APPROX_CHECK_POINTS ||
+                depth == APPROX_MAX_DEPTH) {
+                cell->exact = true;
+                continue;
+            }
+
+            /* Subdivide, the corners of the children being the corners of
+             * the cell and its first 5 check points */
+            const double xmid = cell->xmin + 0.5 * (cell->xmax - cell->xmin);
+            const double ymid = cell->ymin + 0.5 * (cell->ymax - cell->ymin);
+            const PJ_COORD center = exactOfCell[0];
+            const PJ_COORD south = exactOfCell[1];
+            const PJ_COORD west = exactOfCell[2];
+            const PJ_COORD east = exactOfCell[3];
+            const PJ_COORD north = exactOfCell[4];
+            const PJ_COORD corners[4] = {cell->corners[0], cell->corners[1],
+                                         cell->corners[2], cell->corners[3]};
+            const double xmin = cell->xmin;
+            const double ymin = cell->ymin;
+            const double xmax = cell->xmax;
+            const double ymax = cell->ymax;
+
+            const size_t firstChild = approx->cells.size();
+            cell->firstChild = static_cast<int>(firstChild);
+            /* cell is invalidated by the growth of cells */
+            approx->cells.resize(firstChild + 4);
+            auto *children = &approx->cells[firstChild];
+            children[0].xmin = xmin;
+            children[0].ymin = ymin;
+            children[0].xmax = xmid;
+            children[0].ymax = ymid;
+            children[0].corners[0] = corners[0];
+            children[0].corners[1] = south;
+            children[0].corners[2] = west;
+            children[0].corners[3] = center;
+
+            children[1].xmin = xmid;
+            children[1].ymin = ymin;
+            children[1].xmax = xmax;
+            children[1].ymax = ymid;
+            children[1].corners[0] = south;
+            children[1].corners[1] = corners[1];
+            children[1].corners[2] = center;
+            children[1].corners[3] = east;
+
+            children[2].xmin = xmin;
+            children[2].ymin = ymid;
+            children[2].xmax = xmid;
+            children[2].ymax = ymax;
+            children[2].corners[0] = west;
+            children[2].corners[1] = center;
+            children[2].corners[2] = corners[2];
+            children[2].corners[3] = north;
+
+            children[3].xmin = xmid;
+            children[3].ymin = ymid;
+            children[3].xmax = xmax;
+            children[3].ymax = ymax;
+            children[3].corners[0] = center;
+            children[3].corners[1] = east;
+            children[3].corners[2] = north;
+            children[3].corners[3] = corners[3];
+
+            for (size_t k = 0; k < 4; k++)
+                next.push_back(firstChild + k);
+        }
+        pending = std::move(next);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Create an approximate transformer over an extent.
+ *
+ * The transformer answers queries by interpolating the transformation
+ * between control points, which is much faster than evaluating it for each
+ * point when transforming dense sets of points, such as the pixels of a
+ * raster being reprojected.
+ *
+ * The extent is recursively subdivided into cells, until bilinear
+ * interpolation between the transformed corners of each cell reproduces the
+ * exact transformation within max_error at a set of check points of the
+ * cell. Points falling in cells that do not reach that accuracy after 8
+ * levels of subdivision (typically near discontinuities, such as the edges
+ * of a grid, or where some points cannot be transformed) are transformed
+ * exactly by proj_trans_approx_array().
+ *
+ * The transformation is approximated for points whose third coordinate is
+ * 0 and whose time is unknown, and the third component of the output is
+ * interpolated like the first two.
+ *
+ * The transformer keeps a reference to P, which must not be destroyed
+ * before it. As P, it must not be used by several threads at once.
+ *
+ * @param ctx the PJ_CONTEXT object (or NULL for the default context)
+ * @param P the PJ object representing the transformation.
+ * @param direction the direction of the transformation.
+ * @param xmin Minimum bounding coordinate of the first axis of the input
+ * coordinates, in the units and axis order expected by proj_trans().
+ * @param ymin Minimum bounding coordinate of the second axis of the input.
+ * @param xmax Maximum bounding coordinate of the first axis of the input.
+ * @param ymax Maximum bounding coordinate of the second axis of the input.
+ * @param max_error Maximum error of each component of the output, in the
+ * units of the output coordinates. Must be strictly positive.
+ * @return a new object that must be freed with proj_trans_approx_destroy(),
+ * or NULL in case of error.
+ * @since 9.9
+ */
+PJ_TRANS_APPROX *proj_trans_approx_create(PJ_CONTEXT *ctx, PJ *P,
+                                          PJ_DIRECTION direction, double xmin,
+                                          double ymin, double xmax,
+                                          double ymax, double max_error) {
+    if (P == nullptr) {
+        pj_log(ctx, PJ_LOG_ERROR, _("NULL P object not allowed."));
+        proj_context_errno_set(ctx, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return nullptr;
+    }
+    if (direction != PJ_FWD && direction != PJ_INV) {
+        proj_log_error(P, _("direction must be PJ_FWD or PJ_INV."));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return nullptr;
+    }
+    if (!(xmin < xmax && ymin < ymax) || !std::isfinite(xmin) ||
+        !std::isfinite(ymin) || !std::isfinite(xmax) || !std::isfinite(ymax)) {
+        proj_log_error(P, _("Invalid extent."));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return nullptr;
+    }
+    if (!(max_error > 0)) {
+        proj_log_error(P, _("max_error must be strictly positive."));
+        proj_errno_set(P, PROJ_ERR_INVALID_OP_ILLEGAL_ARG_VALUE);
+        return nullptr;
+    }
+
+    auto approx = new PJ_TRANS_APPROX();
+    approx->P = P;
+    approx->direction = direction;
+    approx->maxError = max_error;
+
+    ApproxCell root;
+    root.xmin = xmin;
+    root.ymin = ymin;
+    root.xmax = xmax;
+    root.ymax = ymax;
+    root.corners[0] = approx_control_point(xmin, ymin);
+    root.corners[1] = approx_control_point(xmax, ymin);
+    root.corners[2] = approx_control_point(xmin, ymax);
+    root.corners[3] = approx_control_point(xmax, ymax);
+    proj_trans_array(P, direction, 4, root.corners);
+    approx->cells.push_back(root);
+
+    approx_subdivide(approx);
+
+    proj_errno_reset(P);
+    return approx;
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Return the leaf cell in which (x, y) falls, or nullptr if it is
+ * outside of the extent of the transformer. */
+static const ApproxCell *approx_find_leaf(PJ_TRANS_APPROX *approx, double x,
+                                          double y) {
+    const auto contains = [x, y](const ApproxCell &cell) {
+        return x >= cell.xmin && x <= cell.xmax && y >= cell.ymin &&
+               y <= cell.ymax;
+    };
+
+    /* Consecutive points are generally close to each other */
+    const auto &last = approx->cells[approx->lastLeaf];
+    if (last.firstChild < 0 && contains(last))
+        return &last;
+
+    const ApproxCell *cell = &approx->cells[0];
+    if (!contains(*cell))
+        return nullptr;
+    while (cell->firstChild >= 0) {
+        const double xmid = cell->xmin + 0.5 * (cell->xmax - cell->xmin);
+        const double ymid = cell->ymin + 0.5 * (cell->ymax - cell->ymin);
+        const int child = (x < xmid ? 0 : 1) + (y < ymid ? 0 : 2);
+        cell = &approx->cells[cell->firstChild + child];
+    }
+    approx->lastLeaf = static_cast<size_t>(cell - approx->cells.data());
+    return cell;
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Transform an array of coordinates with an approximate transformer.
+ *
+ * Points inside of the extent of the transformer are interpolated, or
+ * transformed exactly in the parts of the extent where interpolation is not
+ * accurate enough. Points outside of it are transformed exactly. The third
+ * component of the input coordinates is ignored, as documented in
+ * proj_trans_approx_create(), and their time is left unchanged.
+ *
+ * As with proj_trans_array(), individual points that fail to transform will
+ * have their components set to HUGE_VAL.
+ *
+ * @param approx the approximate transformer.
+ * @param n number of coordinates in coord.
+ * @param coord array of coordinates, transformed in place.
+ * @return 0 if all coordinates are transformed without error, otherwise the
+ * error number, as with proj_trans_array().
+ * @since 9.9
+ */
+int proj_trans_approx_array(PJ_TRANS_APPROX *approx, size_t n,
+                            PJ_COORD *coord) {
+    if (approx == nullptr)
+        return PROJ_ERR_OTHER_API_MISUSE;
+
+    std::vector<size_t> exactIdx;
+    for (size_t i = 0; i < n; i++) {
+        const double x = coord[i].v[0];
+        const double y = coord[i].v[1];
+        const auto cell = approx_find_leaf(approx, x, y);
+        if (cell == nullptr || cell->exact) {
+            exactIdx.push_back(i);
+            continue;
+        }
+        const double t = coord[i].v[3];
+        coord[i] = approx_interpolate(*cell, x, y);
+        coord[i].v[3] = t;
+    }
+
+    if (exactIdx.empty())
+        return 0;
+
+    std::vector<PJ_COORD> exact;
+    exact.reserve(exactIdx.size());
+    for (const size_t i : exactIdx)
+        exact.push_back(approx_control_point(coord[i].v[0], coord[i].v[1]));
+    const int err = proj_trans_array(approx->P, approx->direction,
+                                     exact.size(), exact.data());
+    for (size_t k = 0; k < exactIdx.size(); k++) {
+        auto &c = coord[exactIdx[k]];
+        if (exact[k].v[0] == HUGE_VAL) {
+            c = proj_coord_error();
+            continue;
+        }
+        const double t = c.v[3];
+        c = exact[k];
+        c.v[3] = t;
+    }
+    return err;
+}
+
+// ---------------------------------------------------------------------------
+
+/** \brief Free an approximate transformer.
+ *
+ * @param approx the object to free (may be NULL)
+ * @since 9.9
+ */
+void proj_trans_approx_destroy(PJ_TRANS_APPROX *approx) { delete approx; }
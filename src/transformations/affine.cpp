@@ -110,6 +110,32 @@ static PJ_LP reverse_2d(PJ_XY xy, PJ *P) {
     return point.lp;
 }
 
+static bool get_affine(const PJ *P, PJ_DIRECTION dir, double m[3][4]) {
+    const struct pj_opaque_affine *Q =
+        (const struct pj_opaque_affine *)P->opaque;
+    if (Q->toff != 0.0 || Q->forward.tscale != 1.0)
+        return false;
+    if (dir == PJ_INV && P->inv4d == nullptr)
+        return false;
+
+    const struct pj_affine_coeffs *C =
+        dir == PJ_INV ? &(Q->reverse) : &(Q->forward);
+    const double S[3][3] = {{C->s11, C->s12, C->s13},
+                            {C->s21, C->s22, C->s23},
+                            {C->s31, C->s32, C->s33}};
+    const double off[3] = {Q->xoff, Q->yoff, Q->zoff};
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++)
+            m[i][j] = S[i][j];
+        if (dir == PJ_INV)
+            m[i][3] =
+                -(S[i][0] * off[0] + S[i][1] * off[1] + S[i][2] * off[2]);
+        else
+            m[i][3] = off[i];
+    }
+    return true;
+}
+
 static struct pj_opaque_affine *initQ() {
     struct pj_opaque_affine *Q = static_cast<struct pj_opaque_affine *>(
         calloc(1, sizeof(struct pj_opaque_affine)));
@@ -188,6 +214,7 @@ PJ *PJ_TRANSFORMATION(affine, 0 /* no need for ellipsoid */) {
     P->inv3d = reverse_3d;
     P->fwd = forward_2d;
     P->inv = reverse_2d;
+    P->get_affine = get_affine;
 
     P->left = PJ_IO_UNITS_WHATEVER;
     P->right = PJ_IO_UNITS_WHATEVER;
@@ -473,6 +473,188 @@ static void helmert_reverse_4d(PJ_COORD &point, PJ *P) {
     point.lpz = lpz;
 }
 
+/***********************************************************************/
+static size_t helmert_batch_run(PJ_COORD *coo, size_t i, size_t n, PJ *P) {
+    /***********************************************************************
+        Update the parameters for the observation time of coo[i], and
+        return the end of the run of points sharing that observation
+        time, so that the points of the run can be transformed in a
+        tight loop without rebuilding the rotation matrix.
+    ***********************************************************************/
+    struct pj_opaque_helmert *Q = (struct pj_opaque_helmert *)P->opaque;
+    const double t = coo[i].xyzt.t;
+    double t_obs = (t == HUGE_VAL) ? Q->t_epoch : t;
+    if (t_obs != Q->t_obs) {
+        Q->t_obs = t_obs;
+        update_parameters(P);
+        build_rot_matrix(P);
+    }
+    size_t j = i + 1;
+    while (j < n && (coo[j].xyzt.t == t || HUGE_VAL == coo[j].v[0]))
+        j++;
+    return j;
+}
+
+/***********************************************************************/
+static void helmert_forward_4d_batch(PJ_COORD *coo, size_t n, int *,
+                                     PJ *P) {
+    /***********************************************************************
+        Batch version of helmert_forward_4d()
+    ***********************************************************************/
+    struct pj_opaque_helmert *Q = (struct pj_opaque_helmert *)P->opaque;
+
+    size_t i = 0;
+    while (i < n) {
+        if (HUGE_VAL == coo[i].v[0]) {
+            i++;
+            continue;
+        }
+        const size_t end = helmert_batch_run(coo, i, n, P);
+
+        if (Q->fourparam) {
+            for (; i < end; i++) {
+                if (HUGE_VAL == coo[i].v[0])
+                    continue;
+                const auto xy = helmert_forward(coo[i].lp, P);
+                coo[i].xy = xy;
+            }
+        } else if (Q->no_rotation && Q->scale == 0) {
+            const PJ_XYZ xyz = Q->xyz;
+            for (; i < end; i++) {
+                if (HUGE_VAL == coo[i].v[0])
+                    continue;
+                coo[i].xyz.x += xyz.x;
+                coo[i].xyz.y += xyz.y;
+                coo[i].xyz.z += xyz.z;
+            }
+        } else {
+            /* Local copies, as stores to coo[] could alias Q */
+            const double scale = 1 + Q->scale * 1e-6;
+            const PJ_XYZ refp = Q->refp;
+            const PJ_XYZ xyz = Q->xyz;
+            const double r00 = R00, r01 = R01, r02 = R02;
+            const double r10 = R10, r11 = R11, r12 = R12;
+            const double r20 = R20, r21 = R21, r22 = R22;
+            for (; i < end; i++) {
+                if (HUGE_VAL == coo[i].v[0])
+                    continue;
+                const double X = coo[i].xyz.x - refp.x;
+                const double Y = coo[i].xyz.y - refp.y;
+                const double Z = coo[i].xyz.z - refp.z;
+                coo[i].xyz.x = scale * (r00 * X + r01 * Y + r02 * Z) + xyz.x;
+                coo[i].xyz.y = scale * (r10 * X + r11 * Y + r12 * Z) + xyz.y;
+                coo[i].xyz.z = scale * (r20 * X + r21 * Y + r22 * Z) + xyz.z;
+            }
+        }
+    }
+}
+
+/***********************************************************************/
+static void helmert_reverse_4d_batch(PJ_COORD *coo, size_t n, int *,
+                                     PJ *P) {
+    /***********************************************************************
+        Batch version of helmert_reverse_4d()
+    ***********************************************************************/
+    struct pj_opaque_helmert *Q = (struct pj_opaque_helmert *)P->opaque;
+
+    size_t i = 0;
+    while (i < n) {
+        if (HUGE_VAL == coo[i].v[0]) {
+            i++;
+            continue;
+        }
+        const size_t end = helmert_batch_run(coo, i, n, P);
+
+        if (Q->fourparam) {
+            for (; i < end; i++) {
+                if (HUGE_VAL == coo[i].v[0])
+                    continue;
+                const auto lp = helmert_reverse(coo[i].xy, P);
+                coo[i].lp = lp;
+            }
+        } else if (Q->no_rotation && Q->scale == 0) {
+            const PJ_XYZ xyz = Q->xyz;
+            for (; i < end; i++) {
+                if (HUGE_VAL == coo[i].v[0])
+                    continue;
+                coo[i].xyz.x -= xyz.x;
+                coo[i].xyz.y -= xyz.y;
+                coo[i].xyz.z -= xyz.z;
+            }
+        } else {
+            /* Local copies, as stores to coo[] could alias Q */
+            const double scale = 1 + Q->scale * 1e-6;
+            const PJ_XYZ refp = Q->refp;
+            const PJ_XYZ xyz = Q->xyz;
+            const double r00 = R00, r01 = R01, r02 = R02;
+            const double r10 = R10, r11 = R11, r12 = R12;
+            const double r20 = R20, r21 = R21, r22 = R22;
+            for (; i < end; i++) {
+                if (HUGE_VAL == coo[i].v[0])
+                    continue;
+                const double X = (coo[i].xyz.x - xyz.x) / scale;
+                const double Y = (coo[i].xyz.y - xyz.y) / scale;
+                const double Z = (coo[i].xyz.z - xyz.z) / scale;
+                coo[i].xyz.x = (r00 * X + r10 * Y + r20 * Z) + refp.x;
+                coo[i].xyz.y = (r01 * X + r11 * Y + r21 * Z) + refp.y;
+                coo[i].xyz.z = (r02 * X + r12 * Y + r22 * Z) + refp.z;
+            }
+        }
+    }
+}
+
+/***********************************************************************/
+static bool helmert_get_affine(const PJ *P, PJ_DIRECTION dir,
+                               double m[3][4]) {
+    /***********************************************************************
+        Matrix form of helmert_forward_3d() / helmert_reverse_3d(), only
+        available when none of the parameters depends on the epoch.
+        Both are written as out = M * (in - B) + A.
+    ***********************************************************************/
+    const struct pj_opaque_helmert *Q =
+        (const struct pj_opaque_helmert *)P->opaque;
+    const bool inv = dir == PJ_INV;
+    double M[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    PJ_XYZ A = {0, 0, 0};
+    PJ_XYZ B = {0, 0, 0};
+    int i, j;
+
+    if (Q->dxyz.x != 0 || Q->dxyz.y != 0 || Q->dxyz.z != 0 ||
+        Q->dopk.o != 0 || Q->dopk.p != 0 || Q->dopk.k != 0 ||
+        Q->dscale != 0 || Q->dtheta != 0)
+        return false;
+
+    if (Q->fourparam) {
+        const double scale = inv ? 1 / Q->scale : Q->scale;
+        const double cr = cos(Q->theta) * scale;
+        const double sr = sin(Q->theta) * scale;
+        M[0][0] = cr;
+        M[0][1] = inv ? -sr : sr;
+        M[1][0] = -M[0][1];
+        M[1][1] = cr;
+        PJ_XYZ &offset = inv ? B : A;
+        offset.x = Q->xyz_0.x;
+        offset.y = Q->xyz_0.y;
+    } else if (Q->no_rotation && Q->scale == 0) {
+        (inv ? B : A) = Q->xyz;
+    } else {
+        const double scale = 1 + Q->scale * 1e-6;
+        for (i = 0; i < 3; i++)
+            for (j = 0; j < 3; j++)
+                M[i][j] = inv ? Q->R[j][i] / scale : Q->R[i][j] * scale;
+        A = inv ? Q->refp : Q->xyz;
+        B = inv ? Q->xyz : Q->refp;
+    }
+
+    const double a[3] = {A.x, A.y, A.z};
+    for (i = 0; i < 3; i++) {
+        for (j = 0; j < 3; j++)
+            m[i][j] = M[i][j];
+        m[i][3] = a[i] - (M[i][0] * B.x + M[i][1] * B.y + M[i][2] * B.z);
+    }
+    return true;
+}
+
 /* Arcsecond to radians */
 #define ARCSEC_TO_RAD (DEG_TO_RAD / 3600.0)
 
@@ -572,8 +754,11 @@ PJ *PJ_TRANSFORMATION(helmert, 0) {
 
     P->fwd4d = helmert_forward_4d;
     P->inv4d = helmert_reverse_4d;
+    P->fwd4d_batch = helmert_forward_4d_batch;
+    P->inv4d_batch = helmert_reverse_4d_batch;
     P->fwd3d = helmert_forward_3d;
     P->inv3d = helmert_reverse_3d;
+    P->get_affine = helmert_get_affine;
 
     Q = (struct pj_opaque_helmert *)P->opaque;
 
@@ -707,6 +892,7 @@ PJ *PJ_TRANSFORMATION(molobadekas, 0) {
 
     P->fwd3d = helmert_forward_3d;
     P->inv3d = helmert_reverse_3d;
+    P->get_affine = helmert_get_affine;
 
     Q = (struct pj_opaque_helmert *)P->opaque;
 
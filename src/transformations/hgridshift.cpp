@@ -25,11 +25,10 @@ struct hgridshiftData {
 };
 } // anonymous namespace
 
-static PJ_XYZ pj_hgridshift_forward_3d(PJ_LPZ lpz, PJ *P) {
+/* Open the grids if their opening was deferred. Returns false, and sets
+ * the error, if they could not be opened. */
+static bool pj_hgridshift_open_grids(PJ *P) {
     auto Q = static_cast<hgridshiftData *>(P->opaque);
-    PJ_COORD point = {{0, 0, 0, 0}};
-    point.lpz = lpz;
-
     if (Q->defer_grid_opening) {
         Q->defer_grid_opening = false;
         Q->grids = pj_hgrid_init(P, "grids");
@@ -37,8 +36,18 @@ static PJ_XYZ pj_hgridshift_forward_3d(PJ_LPZ lpz, PJ *P) {
     }
     if (Q->error_code_in_defer_grid_opening) {
         proj_errno_set(P, Q->error_code_in_defer_grid_opening);
-        return proj_coord_error().xyz;
+        return false;
     }
+    return true;
+}
+
+static PJ_XYZ pj_hgridshift_forward_3d(PJ_LPZ lpz, PJ *P) {
+    auto Q = static_cast<hgridshiftData *>(P->opaque);
+    PJ_COORD point = {{0, 0, 0, 0}};
+    point.lpz = lpz;
+
+    if (!pj_hgridshift_open_grids(P))
+        return proj_coord_error().xyz;
 
     if (!Q->grids.empty()) {
         /* Only try the gridshift if at least one grid is loaded,
@@ -54,15 +63,8 @@ static PJ_LPZ pj_hgridshift_reverse_3d(PJ_XYZ xyz, PJ *P) {
     PJ_COORD point = {{0, 0, 0, 0}};
     point.xyz = xyz;
 
-    if (Q->defer_grid_opening) {
-        Q->defer_grid_opening = false;
-        Q->grids = pj_hgrid_init(P, "grids");
-        Q->error_code_in_defer_grid_opening = proj_errno(P);
-    }
-    if (Q->error_code_in_defer_grid_opening) {
-        proj_errno_set(P, Q->error_code_in_defer_grid_opening);
+    if (!pj_hgridshift_open_grids(P))
         return proj_coord_error().lpz;
-    }
 
     if (!Q->grids.empty()) {
         /* Only try the gridshift if at least one grid is loaded,
@@ -123,6 +125,56 @@ static void pj_hgridshift_reverse_4d(PJ_COORD &coo, PJ *P) {
     }
 }
 
+static void pj_hgridshift_batch(PJ_COORD *coo, size_t n, int *errors, PJ *P,
+                                PJ_DIRECTION direction) {
+    auto Q = static_cast<hgridshiftData *>(P->opaque);
+
+    /* Time restricted: go point by point */
+    if (Q->t_final != 0 && Q->t_epoch != 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (HUGE_VAL == coo[i].v[0])
+                continue;
+            P->ctx->last_errno = 0;
+            if (direction == PJ_FWD)
+                pj_hgridshift_forward_4d(coo[i], P);
+            else
+                pj_hgridshift_reverse_4d(coo[i], P);
+            if (P->ctx->last_errno) {
+                errors[i] = P->ctx->last_errno;
+                coo[i] = proj_coord_error();
+            }
+        }
+        return;
+    }
+
+    if (!pj_hgridshift_open_grids(P)) {
+        for (size_t i = 0; i < n; i++) {
+            if (HUGE_VAL == coo[i].v[0])
+                continue;
+            errors[i] = Q->error_code_in_defer_grid_opening;
+            coo[i] = proj_coord_error();
+        }
+        return;
+    }
+
+    /* Only try the gridshift if at least one grid is loaded,
+     * otherwise just pass the coordinates through unchanged. */
+    if (Q->grids.empty())
+        return;
+
+    pj_hgrid_apply_batch(P->ctx, Q->grids, coo, n, errors, direction);
+}
+
+static void pj_hgridshift_forward_4d_batch(PJ_COORD *coo, size_t n, int *errors,
+                                           PJ *P) {
+    pj_hgridshift_batch(coo, n, errors, P, PJ_FWD);
+}
+
+static void pj_hgridshift_reverse_4d_batch(PJ_COORD *coo, size_t n, int *errors,
+                                           PJ *P) {
+    pj_hgridshift_batch(coo, n, errors, P, PJ_INV);
+}
+
 static PJ *pj_hgridshift_destructor(PJ *P, int errlev) {
     if (nullptr == P)
         return nullptr;
@@ -148,6 +200,8 @@ PJ *PJ_TRANSFORMATION(hgridshift, 0) {
 
     P->fwd4d = pj_hgridshift_forward_4d;
     P->inv4d = pj_hgridshift_reverse_4d;
+    P->fwd4d_batch = pj_hgridshift_forward_4d_batch;
+    P->inv4d_batch = pj_hgridshift_reverse_4d_batch;
     P->fwd3d = pj_hgridshift_forward_3d;
     P->inv3d = pj_hgridshift_reverse_3d;
     P->fwd = nullptr;
@@ -36,7 +36,9 @@
 // clang-format on
 
 #include <cmath>
+#include <limits>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -908,6 +910,35 @@ TEST(gie, list_functions) {
 
 // ---------------------------------------------------------------------------
 
+TEST(gie, operation_and_parameter_lookup) {
+    auto P = proj_create(PJ_DEFAULT_CTX, "+proj=utm +zone=32 +ellps=GRS80");
+    ASSERT_TRUE(P != nullptr);
+    proj_destroy(P);
+
+    // Unknown operations, including prefixes and extensions of known ones
+    for (const char *def : {"+proj=ut +ellps=GRS80", "+proj=utmx +ellps=GRS80",
+                            "+proj=", "+proj=aaaa", "+proj=zzzz"}) {
+        P = proj_create(PJ_DEFAULT_CTX, def);
+        EXPECT_TRUE(P == nullptr) << def;
+        proj_destroy(P);
+    }
+    proj_errno_reset(nullptr);
+
+    // A parameter name must not match a longer one sharing its prefix
+    auto P1 = proj_create(PJ_DEFAULT_CTX, "+proj=tmerc +ellps=GRS80 +k_0=2");
+    auto P2 = proj_create(PJ_DEFAULT_CTX, "+proj=tmerc +ellps=GRS80 +k_00=2");
+    ASSERT_TRUE(P1 != nullptr);
+    ASSERT_TRUE(P2 != nullptr);
+    const PJ_COORD c = proj_coord(proj_torad(1), proj_torad(45), 0, 0);
+    const PJ_COORD c1 = proj_trans(P1, PJ_FWD, c);
+    const PJ_COORD c2 = proj_trans(P2, PJ_FWD, c);
+    EXPECT_NEAR(c1.xy.x, 2 * c2.xy.x, 1e-6);
+    proj_destroy(P1);
+    proj_destroy(P2);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(gie, io_predicates) {
     /* check io-predicates */
 
@@ -1502,6 +1533,450 @@ TEST(gie, proj_trans_generic) {
 
 // ---------------------------------------------------------------------------
 
+TEST(gie, proj_trans_array_batch_same_as_proj_trans) {
+    // More points than a single batch chunk, with a few failing ones
+    // and a NaN one in the middle
+    const char *const defs[] = {
+        "+proj=pipeline +step +proj=axisswap +order=2,1 "
+        "+step +proj=unitconvert +xy_in=deg +xy_out=rad "
+        "+step +proj=cart +ellps=GRS80 "
+        "+step +proj=helmert +x=1 +y=2 +z=3 +rx=0.1 +ry=0.2 +rz=0.3 +s=1 "
+        "+convention=position_vector "
+        "+step +inv +proj=cart +ellps=WGS84 "
+        "+step +proj=utm +zone=32 +ellps=WGS84",
+        // push/pop steps must keep being applied point by point
+        "+proj=pipeline +step +proj=unitconvert +xy_in=deg +xy_out=rad "
+        "+step +proj=push +v_3 "
+        "+step +proj=cart +ellps=GRS80 "
+        "+step +proj=helmert +x=10 +y=20 +z=30 "
+        "+step +inv +proj=cart +ellps=WGS84 "
+        "+step +proj=pop +v_3 "
+        "+step +proj=unitconvert +xy_in=rad +xy_out=deg"};
+
+    for (const char *def : defs) {
+        auto P = proj_create(PJ_DEFAULT_CTX, def);
+        ASSERT_TRUE(P != nullptr);
+
+        constexpr int N = 1000;
+        std::vector<PJ_COORD> coords;
+        for (int i = 0; i < N; i++) {
+            coords.push_back(proj_coord(40 + (i % 40) * 0.5,
+                                        -5 + (i % 35) * 0.5, i, 2020));
+        }
+        coords[10].xyzt.x = 100; // invalid latitude for the first pipeline
+        coords[500].xyzt.y = std::numeric_limits<double>::quiet_NaN();
+
+        std::vector<PJ_COORD> expected;
+        for (const auto &coord : coords) {
+            expected.push_back(proj_trans(P, PJ_FWD, coord));
+        }
+
+        proj_trans_array(P, PJ_FWD, coords.size(), coords.data());
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < 4; j++) {
+                if (std::isnan(expected[i].v[j])) {
+                    EXPECT_TRUE(std::isnan(coords[i].v[j])) << i;
+                } else {
+                    EXPECT_EQ(coords[i].v[j], expected[i].v[j]) << i;
+                }
+            }
+        }
+
+        proj_destroy(P);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_trans_array_tmerc_batch_same_as_proj_trans) {
+    // Transverse Mercator has batch kernels for its ellipsoidal variants:
+    // check them against the point-wise functions, in both directions for
+    // the exact one, with points outside the domain of validity and a
+    // number of points that isn't a multiple of the batch size
+    const struct {
+        const char *def;
+        PJ_DIRECTION direction;
+    } cases[] = {
+        {"+proj=utm +zone=32 +ellps=GRS80", PJ_FWD},
+        {"+proj=utm +zone=32 +ellps=GRS80", PJ_INV},
+        {"+proj=tmerc +lat_0=10 +lon_0=9 +k=0.9996 +ellps=bessel", PJ_FWD},
+        {"+proj=tmerc +lat_0=10 +lon_0=9 +k=0.9996 +ellps=bessel", PJ_INV},
+        {"+proj=tmerc +approx +lat_0=10 +lon_0=9 +ellps=bessel", PJ_FWD},
+        {"+proj=utm +zone=32 +approx +ellps=GRS80", PJ_FWD}};
+
+    for (const auto &c : cases) {
+        auto P = proj_create(PJ_DEFAULT_CTX, c.def);
+        ASSERT_TRUE(P != nullptr);
+
+        constexpr int N = 1003;
+        std::vector<PJ_COORD> coords;
+        for (int i = 0; i < N; i++) {
+            if (c.direction == PJ_FWD) {
+                coords.push_back(proj_coord(proj_torad(-20 + (i % 97) * 0.6),
+                                            proj_torad(-85 + (i % 89) * 1.9),
+                                            i, 2020));
+            } else {
+                coords.push_back(proj_coord(-1e6 + (i % 97) * 3e4,
+                                            -9e6 + (i % 89) * 2e5, i, 2020));
+            }
+        }
+        // Outside of the domain of the exact and approximate algorithms
+        if (c.direction == PJ_FWD) {
+            coords[7].xyzt.x = proj_torad(9 + 90);
+            coords[7].xyzt.y = 0;
+            coords[8].xyzt.x = proj_torad(9 - 100);
+        } else {
+            coords[7].xyzt.x = 3e7;
+            coords[8].xyzt.x = -2e7;
+        }
+
+        std::vector<PJ_COORD> expected;
+        for (const auto &coord : coords) {
+            expected.push_back(proj_trans(P, c.direction, coord));
+        }
+
+        proj_trans_array(P, c.direction, coords.size(), coords.data());
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < 4; j++) {
+                EXPECT_EQ(coords[i].v[j], expected[i].v[j])
+                    << c.def << " " << i;
+            }
+        }
+        EXPECT_TRUE(coords[7].xyzt.x == HUGE_VAL ||
+                    coords[8].xyzt.x == HUGE_VAL)
+            << c.def;
+
+        proj_destroy(P);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_trans_array_cart_helmert_batch_same_as_proj_trans) {
+    // cart and helmert have batch kernels: check them against the
+    // point-wise functions, with points at the poles and at the centre of
+    // the Earth, and time-dependent Helmert parameters with observation
+    // epochs changing along the array
+    const struct {
+        const char *def;
+        PJ_DIRECTION direction;
+        bool geographic_input;
+    } cases[] = {
+        {"+proj=cart +ellps=GRS80", PJ_FWD, true},
+        {"+proj=cart +ellps=GRS80", PJ_INV, false},
+        {"+proj=cart +R=6400000", PJ_INV, false},
+        {"+proj=helmert +x=0.0127 +y=0.0065 +z=-0.0209 +s=0.00195 "
+         "+rx=-0.00039 +ry=0.00080 +rz=-0.00114 +dx=-0.0029 +dy=-0.0002 "
+         "+dz=-0.0006 +ds=0.00001 +drx=-0.00011 +dry=-0.00019 +drz=0.00007 "
+         "+t_epoch=1988.0 +convention=coordinate_frame",
+         PJ_FWD, false},
+        {"+proj=helmert +x=0.0127 +y=0.0065 +z=-0.0209 +s=0.00195 "
+         "+rx=-0.00039 +ry=0.00080 +rz=-0.00114 +dx=-0.0029 +dy=-0.0002 "
+         "+dz=-0.0006 +ds=0.00001 +drx=-0.00011 +dry=-0.00019 +drz=0.00007 "
+         "+t_epoch=1988.0 +convention=coordinate_frame",
+         PJ_INV, false},
+        {"+proj=helmert +x=10 +y=20 +z=30", PJ_INV, false},
+        {"+proj=helmert +x=10 +y=20 +theta=12 +s=1.2", PJ_FWD, false}};
+
+    for (const auto &c : cases) {
+        auto P = proj_create(PJ_DEFAULT_CTX, c.def);
+        ASSERT_TRUE(P != nullptr);
+
+        constexpr int N = 1003;
+        std::vector<PJ_COORD> coords;
+        for (int i = 0; i < N; i++) {
+            const double t = 2000 + (i / 10) % 3;
+            if (c.geographic_input) {
+                coords.push_back(proj_coord(proj_torad(-180 + (i % 97) * 3.7),
+                                            proj_torad(-90 + (i % 89) * 2.1),
+                                            -100 + i, t));
+            } else {
+                coords.push_back(proj_coord(-6.4e6 + (i % 97) * 1.3e5,
+                                            -6.4e6 + (i % 89) * 1.4e5,
+                                            -6.4e6 + (i % 83) * 1.5e5, t));
+            }
+        }
+        if (c.geographic_input) {
+            coords[5].xyzt.y = proj_torad(90);
+            coords[6].xyzt.y = proj_torad(-90);
+        } else {
+            coords[5] = proj_coord(0, 0, 0, 2000);
+            coords[6] = proj_coord(0, 0, 6356752, 2000);
+            coords[7] = proj_coord(0, 1e-3, -6356752, 2000);
+        }
+
+        std::vector<PJ_COORD> expected;
+        for (const auto &coord : coords) {
+            expected.push_back(proj_trans(P, c.direction, coord));
+        }
+
+        proj_trans_array(P, c.direction, coords.size(), coords.data());
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < 4; j++) {
+                EXPECT_EQ(coords[i].v[j], expected[i].v[j])
+                    << c.def << " " << i;
+            }
+        }
+
+        proj_destroy(P);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_trans_array_grid_shift_batch_same_as_proj_trans) {
+    // hgridshift and vgridshift have batch kernels, reading the nodes around
+    // runs of points at once: check them against the point-wise functions,
+    // for rows of a raster crossing subgrids and the edges of the grids, and
+    // for scattered points
+    const struct {
+        const char *def;
+        PJ_DIRECTION direction;
+    } cases[] = {
+        {"+proj=hgridshift +grids=tests/ntv2_0_downsampled.gsb", PJ_FWD},
+        {"+proj=hgridshift +grids=tests/ntv2_0_downsampled.gsb", PJ_INV},
+        {"+proj=hgridshift +grids=tests/ntv2_0_downsampled.gsb,null", PJ_FWD},
+        {"+proj=hgridshift +grids=tests/ntv2_0_downsampled.gsb "
+         "+t_epoch=2001 +t_final=2010",
+         PJ_FWD},
+        {"+proj=vgridshift +grids=tests/egm96_15_downsampled.gtx "
+         "+multiplier=1",
+         PJ_FWD},
+        {"+proj=vgridshift +grids=tests/egm96_15_downsampled.gtx "
+         "+multiplier=1",
+         PJ_INV},
+        {"+proj=vgridshift +grids=tests/test_nodata.gtx,null +multiplier=1",
+         PJ_FWD}};
+
+    std::vector<PJ_COORD> raster;
+    for (int row = 0; row < 30; row++) {
+        for (int col = 0; col < 301; col++) {
+            raster.push_back(proj_coord(proj_torad(-125 + col * 0.2),
+                                        proj_torad(38 + row * 0.8), 100,
+                                        2000 + row % 3));
+        }
+    }
+    std::vector<PJ_COORD> scattered;
+    for (int i = 0; i < 1003; i++) {
+        scattered.push_back(proj_coord(proj_torad(-180 + (i * 37 % 360)),
+                                       proj_torad(-89 + (i * 53 % 179)), 100,
+                                       2000 + i % 3));
+    }
+
+    for (const auto &c : cases) {
+        auto P = proj_create(PJ_DEFAULT_CTX, c.def);
+        ASSERT_TRUE(P != nullptr) << c.def;
+
+        for (const auto *input : {&raster, &scattered}) {
+            std::vector<PJ_COORD> coords(*input);
+            std::vector<PJ_COORD> expected;
+            for (const auto &coord : coords) {
+                expected.push_back(proj_trans(P, c.direction, coord));
+            }
+
+            proj_trans_array(P, c.direction, coords.size(), coords.data());
+            for (size_t i = 0; i < coords.size(); i++) {
+                for (int j = 0; j < 4; j++) {
+                    EXPECT_EQ(coords[i].v[j], expected[i].v[j])
+                        << c.def << " " << i;
+                }
+            }
+        }
+
+        proj_destroy(P);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, pipeline_fused_steps_same_as_individual_steps) {
+    // Consecutive affine steps, and the cart round trip, are run as a
+    // single matrix product: check this against running the steps one
+    // after the other
+    const char *const pipeline_def =
+        "+proj=pipeline +step +proj=axisswap +order=2,1 "
+        "+step +proj=unitconvert +xy_in=km +xy_out=m +z_in=km +z_out=m "
+        "+step +proj=affine +xoff=10 +s11=2 +s12=0.5 +s33=3 "
+        "+step +proj=helmert +x=1 +y=2 +z=3 +rx=0.1 +ry=0.2 +rz=0.3 +s=1 "
+        "+convention=coordinate_frame +inv "
+        "+step +inv +proj=cart +ellps=GRS80 "
+        "+step +proj=cart +ellps=GRS80 "
+        "+step +proj=helmert +x=100 +y=200 +z=300 +exact +s=2 +rz=1 "
+        "+convention=position_vector";
+    const char *const step_defs[] = {
+        "+proj=axisswap +order=2,1",
+        "+proj=unitconvert +xy_in=km +xy_out=m +z_in=km +z_out=m",
+        "+proj=affine +xoff=10 +s11=2 +s12=0.5 +s33=3",
+        "+proj=helmert +x=1 +y=2 +z=3 +rx=0.1 +ry=0.2 +rz=0.3 +s=1 "
+        "+convention=coordinate_frame +inv",
+        "+proj=cart +ellps=GRS80 +inv",
+        "+proj=cart +ellps=GRS80",
+        "+proj=helmert +x=100 +y=200 +z=300 +exact +s=2 +rz=1 "
+        "+convention=position_vector"};
+
+    auto P = proj_create(PJ_DEFAULT_CTX, pipeline_def);
+    ASSERT_TRUE(P != nullptr);
+    std::vector<PJ *> steps;
+    for (const char *def : step_defs) {
+        steps.push_back(proj_create(PJ_DEFAULT_CTX, def));
+        ASSERT_TRUE(steps.back() != nullptr);
+    }
+
+    const auto expect_same_coord = [](const PJ_COORD &a, const PJ_COORD &b) {
+        for (int j = 0; j < 4; j++) {
+            if (b.v[j] == HUGE_VAL)
+                EXPECT_EQ(a.v[j], HUGE_VAL) << j;
+            else
+                EXPECT_NEAR(a.v[j], b.v[j], 1e-5) << j;
+        }
+    };
+
+    std::vector<PJ_COORD> coords;
+    for (int i = 0; i < 100; i++) {
+        coords.push_back(
+            proj_coord(100 + i * 0.1, 1500 + i * 0.1, 1860 + i * 0.01, 0));
+    }
+    // Not handled by the fused path, but should behave the same
+    coords[50].xyz.z = HUGE_VAL;
+
+    for (const auto &coord : coords) {
+        PJ_COORD expected = coord;
+        for (const auto step : steps)
+            expected = proj_trans(step, PJ_FWD, expected);
+        const PJ_COORD fwd = proj_trans(P, PJ_FWD, coord);
+        expect_same_coord(fwd, expected);
+
+        PJ_COORD expected_inv = fwd;
+        for (auto iter = steps.rbegin(); iter != steps.rend(); ++iter)
+            expected_inv = proj_trans(*iter, PJ_INV, expected_inv);
+        expect_same_coord(proj_trans(P, PJ_INV, fwd), expected_inv);
+    }
+
+    std::vector<PJ_COORD> expected;
+    for (const auto &coord : coords)
+        expected.push_back(proj_trans(P, PJ_FWD, coord));
+    proj_trans_array(P, PJ_FWD, coords.size(), coords.data());
+    for (size_t i = 0; i < coords.size(); i++) {
+        for (int j = 0; j < 4; j++) {
+            EXPECT_EQ(coords[i].v[j], expected[i].v[j]) << i;
+        }
+    }
+
+    for (auto step : steps)
+        proj_destroy(step);
+    proj_destroy(P);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_trans_soa) {
+    auto P = proj_create(PJ_DEFAULT_CTX, "+proj=utm +zone=32 +ellps=GRS80");
+    ASSERT_TRUE(P != nullptr);
+
+    const PJ_COORD ref0 = proj_trans(
+        P, PJ_FWD, proj_coord(proj_torad(12), proj_torad(55), 45, 0));
+    const PJ_COORD ref2 = proj_trans(
+        P, PJ_FWD, proj_coord(proj_torad(12), proj_torad(56), 0, HUGE_VAL));
+
+    double x[] = {proj_torad(12), proj_torad(12), proj_torad(12),
+                  proj_torad(105)};
+    double y[] = {proj_torad(55), proj_torad(95), proj_torad(56),
+                  proj_torad(0)};
+    double z[] = {45, 45, 0, 0};
+    double t[] = {0, 0, HUGE_VAL, 0};
+    int errors[] = {-1, -1, -1, -1};
+
+    // Two points failing for different reasons
+    EXPECT_EQ(proj_trans_soa(P, PJ_FWD, 4, x, y, z, t, errors),
+              PROJ_ERR_COORD_TRANSFM);
+    EXPECT_EQ(errors[0], 0);
+    EXPECT_EQ(errors[1], PROJ_ERR_COORD_TRANSFM_INVALID_COORD);
+    EXPECT_EQ(errors[2], 0);
+    EXPECT_NE(errors[3], 0);
+    EXPECT_NE(errors[3], PROJ_ERR_COORD_TRANSFM_INVALID_COORD);
+
+    EXPECT_EQ(x[0], ref0.xyzt.x);
+    EXPECT_EQ(y[0], ref0.xyzt.y);
+    EXPECT_EQ(z[0], ref0.xyzt.z);
+    EXPECT_EQ(x[1], HUGE_VAL);
+    EXPECT_EQ(y[1], HUGE_VAL);
+    EXPECT_EQ(x[2], ref2.xyzt.x);
+    EXPECT_EQ(y[2], ref2.xyzt.y);
+    EXPECT_EQ(x[3], HUGE_VAL);
+
+    // Without z, t and errors
+    x[0] = proj_torad(12);
+    y[0] = proj_torad(56);
+    EXPECT_EQ(proj_trans_soa(P, PJ_FWD, 1, x, y, nullptr, nullptr, nullptr),
+              0);
+    EXPECT_EQ(x[0], ref2.xyzt.x);
+    EXPECT_EQ(y[0], ref2.xyzt.y);
+
+    // x and y are required
+    EXPECT_EQ(proj_trans_soa(P, PJ_FWD, 1, x, nullptr, nullptr, nullptr,
+                             nullptr),
+              PROJ_ERR_OTHER_API_MISUSE);
+
+    proj_destroy(P);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST(gie, proj_trans_array_multithreaded) {
+    auto ctx = proj_context_create();
+    proj_context_set_num_threads(ctx, 4);
+    auto P = proj_create(ctx, "+proj=pipeline "
+                              "+step +proj=unitconvert +xy_in=deg +xy_out=rad "
+                              "+step +proj=utm +zone=32 +ellps=GRS80");
+    ASSERT_TRUE(P != nullptr);
+    // Worker threads use clones of P
+    auto clone = proj_clone(ctx, P);
+    ASSERT_TRUE(clone != nullptr);
+    proj_destroy(clone);
+
+    constexpr int N = 300 * 1000;
+    std::vector<PJ_COORD> coords;
+    std::vector<double> x;
+    std::vector<double> y;
+    for (int i = 0; i < N; i++) {
+        coords.push_back(proj_coord(5 + (i % 1000) * 0.01,
+                                    40 + (i / 1000) * 0.01, 0, 0));
+        x.push_back(coords.back().xyzt.x);
+        y.push_back(coords.back().xyzt.y);
+    }
+    coords[N - 1].xyzt.y = 100; // invalid latitude
+    y[N - 1] = 100;
+
+    std::vector<PJ_COORD> expected;
+    for (const auto &coord : coords) {
+        expected.push_back(proj_trans(P, PJ_FWD, coord));
+    }
+
+    EXPECT_EQ(proj_trans_array(P, PJ_FWD, coords.size(), coords.data()),
+              PROJ_ERR_COORD_TRANSFM_INVALID_COORD);
+    EXPECT_EQ(proj_errno(P), PROJ_ERR_COORD_TRANSFM_INVALID_COORD);
+
+    double z = 10;
+    EXPECT_EQ(proj_trans_generic(P, PJ_FWD, x.data(), sizeof(double), N,
+                                 y.data(), sizeof(double), N, &z,
+                                 sizeof(double), 1, nullptr, 0, 0),
+              static_cast<size_t>(N));
+
+    for (int i = 0; i < N; i++) {
+        ASSERT_EQ(coords[i].xyzt.x, expected[i].xyzt.x) << i;
+        ASSERT_EQ(coords[i].xyzt.y, expected[i].xyzt.y) << i;
+        ASSERT_EQ(x[i], expected[i].xyzt.x) << i;
+        ASSERT_EQ(y[i], expected[i].xyzt.y) << i;
+    }
+    // The broadcast value is updated with the result of the last point
+    EXPECT_EQ(z, HUGE_VAL);
+
+    proj_destroy(P);
+    proj_context_destroy(ctx);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST(gie, proj_trans_with_a_crs) {
     auto P = proj_create(PJ_DEFAULT_CTX, "EPSG:4326");
     PJ_COORD input;
@@ -3354,6 +3354,42 @@ TEST_F(CApi, proj_clone_of_obj_with_alternative_operations) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_clone_of_coordinate_operation_in_other_context) {
+    auto obj =
+        proj_create_crs_to_crs(m_ctxt, "EPSG:4326", "EPSG:32631", nullptr);
+    ObjectKeeper keeper(obj);
+    ASSERT_NE(obj, nullptr);
+
+    auto ctx = proj_context_create();
+    auto clone = proj_clone(ctx, obj);
+    ASSERT_NE(clone, nullptr);
+
+    const char *projString =
+        proj_as_proj_string(m_ctxt, obj, PJ_PROJ_5, nullptr);
+    ASSERT_NE(projString, nullptr);
+    const char *projStringClone =
+        proj_as_proj_string(ctx, clone, PJ_PROJ_5, nullptr);
+    ASSERT_NE(projStringClone, nullptr);
+    EXPECT_EQ(std::string(projStringClone), std::string(projString));
+    EXPECT_EQ(std::string(proj_pj_info(clone).definition),
+              std::string(proj_pj_info(obj).definition));
+
+    PJ_COORD c;
+    c.xyzt.x = 49;
+    c.xyzt.y = 2;
+    c.xyzt.z = 0;
+    c.xyzt.t = HUGE_VAL;
+    PJ_COORD c_trans_ref = proj_trans(obj, PJ_FWD, c);
+    PJ_COORD c_trans = proj_trans(clone, PJ_FWD, c);
+    EXPECT_EQ(c_trans.xyzt.x, c_trans_ref.xyzt.x);
+    EXPECT_EQ(c_trans.xyzt.y, c_trans_ref.xyzt.y);
+
+    proj_destroy(clone);
+    proj_context_destroy(ctx);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_crs_alter_geodetic_crs) {
     auto projCRS = proj_create_from_wkt(
         m_ctxt,
@@ -4285,6 +4321,69 @@ TEST_F(CApi, proj_get_crs_info_list_from_database) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_get_crs_info_list_from_database_bbox_filter) {
+    // Check that filtering on a bbox, which is done with the help of a
+    // spatial index, does not miss any CRS whose area of use intersects it.
+    int full_count = 0;
+    auto full_list = proj_get_crs_info_list_from_database(m_ctxt, nullptr,
+                                                          nullptr, &full_count);
+    ASSERT_NE(full_list, nullptr);
+
+    const auto key = [](const PROJ_CRS_INFO *info) {
+        return std::string(info->auth_name) + ':' + info->code + ' ' +
+               std::to_string(info->west_lon_degree) + ' ' +
+               std::to_string(info->south_lat_degree) + ' ' +
+               std::to_string(info->east_lon_degree) + ' ' +
+               std::to_string(info->north_lat_degree);
+    };
+
+    const double bboxes[][4] = {{2, 49, 2.1, 49.1},
+                                {170, -60, -170, -30},
+                                {179.5, 50, 180, 60},
+                                {-180, 60, -179, 70},
+                                {-180, -90, 180, 90}};
+    for (const auto &bboxCoords : bboxes) {
+        auto bbox = GeographicBoundingBox::create(
+            bboxCoords[0], bboxCoords[1], bboxCoords[2], bboxCoords[3]);
+
+        int result_count = 0;
+        auto params = proj_get_crs_list_parameters_create();
+        params->bbox_valid = 1;
+        params->west_lon_degree = bboxCoords[0];
+        params->south_lat_degree = bboxCoords[1];
+        params->east_lon_degree = bboxCoords[2];
+        params->north_lat_degree = bboxCoords[3];
+        params->crs_area_of_use_contains_bbox = 0;
+        params->allow_deprecated = 1;
+        auto list = proj_get_crs_info_list_from_database(m_ctxt, nullptr,
+                                                         params, &result_count);
+        ASSERT_NE(list, nullptr);
+        EXPECT_GT(result_count, 0);
+        std::set<std::string> found;
+        for (int i = 0; i < result_count; i++) {
+            found.insert(key(list[i]));
+        }
+        for (int i = 0; i < full_count; i++) {
+            const auto info = full_list[i];
+            if (!info->bbox_valid) {
+                continue;
+            }
+            auto crsExtent = GeographicBoundingBox::create(
+                info->west_lon_degree, info->south_lat_degree,
+                info->east_lon_degree, info->north_lat_degree);
+            if (crsExtent->intersects(bbox)) {
+                EXPECT_TRUE(found.find(key(info)) != found.end())
+                    << key(info);
+            }
+        }
+        proj_get_crs_list_parameters_destroy(params);
+        proj_crs_info_list_destroy(list);
+    }
+    proj_crs_info_list_destroy(full_list);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_get_units_from_database) {
     { proj_unit_list_destroy(nullptr); }
 
@@ -4878,6 +4977,89 @@ TEST_F(CApi, proj_create_crs_to_crs_from_pj_ballpark_filter) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_create_crs_to_crs_persistent_cache) {
+    const char *tempdir = getenv("TEMP");
+    if (!tempdir) {
+        tempdir = getenv("TMP");
+    }
+    if (!tempdir) {
+        tempdir = "/tmp";
+    }
+    std::string tmp_filename(std::string(tempdir) +
+                             "/test_proj_crs_to_crs_cache.db");
+    std::remove(tmp_filename.c_str());
+
+    proj_crs_to_crs_cache_set_filename(m_ctxt, tmp_filename.c_str());
+    proj_crs_to_crs_cache_set_enable(m_ctxt, true);
+
+    // Single operation
+    {
+        auto P = proj_create_crs_to_crs(m_ctxt, "EPSG:4326", "EPSG:32631",
+                                        nullptr);
+        ObjectKeeper keeper_P(P);
+        ASSERT_NE(P, nullptr);
+        auto srcCRS = proj_get_source_crs(m_ctxt, P);
+        ObjectKeeper keeper_srcCRS(srcCRS);
+        EXPECT_NE(srcCRS, nullptr);
+
+        auto P2 = proj_create_crs_to_crs(m_ctxt, "EPSG:4326", "EPSG:32631",
+                                         nullptr);
+        ObjectKeeper keeper_P2(P2);
+        ASSERT_NE(P2, nullptr);
+        // Operations restored from the cache have no CRS
+        auto srcCRS2 = proj_get_source_crs(m_ctxt, P2);
+        ObjectKeeper keeper_srcCRS2(srcCRS2);
+        EXPECT_EQ(srcCRS2, nullptr);
+        EXPECT_EQ(std::string(proj_get_name(P2)), proj_get_name(P));
+        EXPECT_EQ(proj_coordoperation_get_accuracy(m_ctxt, P2),
+                  proj_coordoperation_get_accuracy(m_ctxt, P));
+
+        PJ_COORD coord = proj_coord(49, 2, 0, HUGE_VAL);
+        PJ_COORD res = proj_trans(P, PJ_FWD, coord);
+        PJ_COORD res2 = proj_trans(P2, PJ_FWD, coord);
+        EXPECT_EQ(res.xy.x, res2.xy.x);
+        EXPECT_EQ(res.xy.y, res2.xy.y);
+    }
+
+    // Several candidate operations
+    {
+        // NAD27 to NAD83
+        auto P =
+            proj_create_crs_to_crs(m_ctxt, "EPSG:4267", "EPSG:4269", nullptr);
+        ObjectKeeper keeper_P(P);
+        ASSERT_NE(P, nullptr);
+
+        auto P2 =
+            proj_create_crs_to_crs(m_ctxt, "EPSG:4267", "EPSG:4269", nullptr);
+        ObjectKeeper keeper_P2(P2);
+        ASSERT_NE(P2, nullptr);
+
+        PJ_COORD coord = proj_coord(40.5, -60, 0, HUGE_VAL);
+        PJ_COORD res = proj_trans(P, PJ_FWD, coord);
+        PJ_COORD res2 = proj_trans(P2, PJ_FWD, coord);
+        EXPECT_EQ(res.xy.x, res2.xy.x);
+        EXPECT_EQ(res.xy.y, res2.xy.y);
+
+        auto op = proj_trans_get_last_used_operation(P);
+        ObjectKeeper keeper_op(op);
+        ASSERT_NE(op, nullptr);
+        auto op2 = proj_trans_get_last_used_operation(P2);
+        ObjectKeeper keeper_op2(op2);
+        ASSERT_NE(op2, nullptr);
+        EXPECT_EQ(std::string(proj_get_name(op2)), proj_get_name(op));
+    }
+
+    proj_crs_to_crs_cache_clear(m_ctxt);
+    proj_crs_to_crs_cache_set_enable(m_ctxt, false);
+    FILE *f = fopen(tmp_filename.c_str(), "rb");
+    EXPECT_EQ(f, nullptr);
+    if (f) {
+        fclose(f);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_create_crs_to_crs_coordinate_metadata_in_src) {
 
     auto P =
@@ -6425,6 +6607,112 @@ TEST_F(CApi, proj_trans_bounds_noop_geographic) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(CApi, proj_trans_approx) {
+    auto P = proj_create(m_ctxt, "+proj=pipeline "
+                                 "+step +proj=unitconvert +xy_in=deg "
+                                 "+xy_out=rad +step +proj=utm +zone=31 "
+                                 "+ellps=GRS80");
+    ObjectKeeper keeper_P(P);
+    ASSERT_NE(P, nullptr);
+
+    constexpr double maxError = 1e-3;
+    auto approx = proj_trans_approx_create(m_ctxt, P, PJ_FWD, 0, 40, 6, 50,
+                                           maxError);
+    ASSERT_NE(approx, nullptr);
+
+    std::vector<PJ_COORD> exact;
+    for (int j = 0; j <= 100; ++j) {
+        for (int i = 0; i <= 100; ++i) {
+            exact.push_back(proj_coord(0.06 * i, 40 + 0.1 * j, 0, 0));
+        }
+    }
+    // Points outside of the extent are transformed exactly
+    exact.push_back(proj_coord(-1, 39, 0, 0));
+    exact.push_back(proj_coord(7, 45, 0, 0));
+    auto approximated = exact;
+
+    EXPECT_EQ(proj_trans_array(P, PJ_FWD, exact.size(), exact.data()), 0);
+    EXPECT_EQ(proj_trans_approx_array(approx, approximated.size(),
+                                      approximated.data()),
+              0);
+    for (size_t i = 0; i < exact.size(); ++i) {
+        EXPECT_NEAR(approximated[i].xy.x, exact[i].xy.x, maxError);
+        EXPECT_NEAR(approximated[i].xy.y, exact[i].xy.y, maxError);
+    }
+    EXPECT_EQ(approximated.back().xy.x, exact.back().xy.x);
+    EXPECT_EQ(approximated.back().xy.y, exact.back().xy.y);
+
+    proj_trans_approx_destroy(approx);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, proj_trans_approx_grid_edges) {
+    // The grid only covers part of the extent: points outside of it fail
+    // in the exact transformation and must fail in the approximated one too.
+    auto P = proj_create(m_ctxt, "+proj=pipeline "
+                                 "+step +proj=unitconvert +xy_in=deg "
+                                 "+xy_out=rad "
+                                 "+step +proj=hgridshift "
+                                 "+grids=tests/ntv2_0_downsampled.gsb "
+                                 "+step +proj=unitconvert +xy_in=rad "
+                                 "+xy_out=deg");
+    ObjectKeeper keeper_P(P);
+    ASSERT_NE(P, nullptr);
+
+    constexpr double maxError = 1e-8;
+    auto approx = proj_trans_approx_create(m_ctxt, P, PJ_FWD, -145, 35,
+                                           -45, 90, maxError);
+    ASSERT_NE(approx, nullptr);
+
+    std::vector<PJ_COORD> exact;
+    for (int j = 0; j <= 55; ++j) {
+        for (int i = 0; i <= 100; ++i) {
+            exact.push_back(proj_coord(-145 + i, 35 + j, 0, 0));
+        }
+    }
+    auto approximated = exact;
+
+    proj_trans_array(P, PJ_FWD, exact.size(), exact.data());
+    proj_trans_approx_array(approx, approximated.size(), approximated.data());
+    int failures = 0;
+    for (size_t i = 0; i < exact.size(); ++i) {
+        if (exact[i].xy.x == HUGE_VAL) {
+            ++failures;
+            EXPECT_EQ(approximated[i].xy.x, HUGE_VAL);
+        } else {
+            EXPECT_NEAR(approximated[i].xy.x, exact[i].xy.x, maxError);
+            EXPECT_NEAR(approximated[i].xy.y, exact[i].xy.y, maxError);
+        }
+    }
+    EXPECT_GT(failures, 0);
+
+    proj_trans_approx_destroy(approx);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(CApi, proj_trans_approx_invalid) {
+    auto P = proj_create(m_ctxt, "+proj=noop");
+    ObjectKeeper keeper_P(P);
+    ASSERT_NE(P, nullptr);
+
+    EXPECT_EQ(proj_trans_approx_create(m_ctxt, nullptr, PJ_FWD, 0, 0, 1, 1,
+                                       1e-3),
+              nullptr);
+    EXPECT_EQ(proj_trans_approx_create(m_ctxt, P, PJ_IDENT, 0, 0, 1, 1, 1e-3),
+              nullptr);
+    EXPECT_EQ(proj_trans_approx_create(m_ctxt, P, PJ_FWD, 1, 0, 0, 1, 1e-3),
+              nullptr);
+    EXPECT_EQ(proj_trans_approx_create(m_ctxt, P, PJ_FWD, 0, 0, 1, 1, 0),
+              nullptr);
+    EXPECT_EQ(proj_trans_approx_create(m_ctxt, P, PJ_FWD, 0, 0, HUGE_VAL, 1,
+                                       1e-3),
+              nullptr);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(CApi, proj_trans_bounds__north_pole_xy) {
     auto P = proj_create_crs_to_crs(m_ctxt, "EPSG:32661", "EPSG:4326", nullptr);
     ObjectKeeper keeper_P(P);
@@ -3970,6 +3970,24 @@ TEST(factory, createObjectsFromName) {
         }
     }
 
+    {
+        // Approximate searches reuse the cached canonicalized names of the
+        // database context: results and their order must be stable.
+        const auto getCodes = [&factoryEPSG]() {
+            std::vector<int> codes;
+            for (const auto &obj : factoryEPSG->createObjectsFromName(
+                     "WGS84", {AuthorityFactory::ObjectType::GEODETIC_CRS},
+                     true)) {
+                codes.push_back(obj->getEPSGCode());
+            }
+            return codes;
+        };
+        const auto codes = getCodes();
+        ASSERT_FALSE(codes.empty());
+        EXPECT_EQ(codes.front(), 4326);
+        EXPECT_EQ(getCodes(), codes);
+    }
+
     // Exact name, but just not the official case ==> should match with exact
     // match
     EXPECT_EQ(factory->createObjectsFromName("WGS 84 / utm zone 31n", {}, false)
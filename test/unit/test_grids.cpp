@@ -28,6 +28,8 @@
 
 #include "gtest_include.h"
 
+#include <set>
+
 #include "grids.hpp"
 
 #include "proj_internal.h" // M_PI
@@ -96,6 +98,61 @@ TEST_F(GridTest, VerticalShiftGridSet_gtx) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(GridTest, VerticalShiftGridSet_gtx_opened_in_several_contexts) {
+    // Both grids share the decoded lines of the file
+    auto gridSet = NS_PROJ::VerticalShiftGridSet::open(
+        m_ctxt, "tests/egm96_15_downsampled.gtx");
+    ASSERT_NE(gridSet, nullptr);
+    auto gridSet2 = NS_PROJ::VerticalShiftGridSet::open(
+        m_ctxt2, "tests/egm96_15_downsampled.gtx");
+    ASSERT_NE(gridSet2, nullptr);
+    auto grid = gridSet->gridAt(0, 0);
+    ASSERT_NE(grid, nullptr);
+    auto grid2 = gridSet2->gridAt(0, 0);
+    ASSERT_NE(grid2, nullptr);
+    for (int y = 0; y < grid->height(); ++y) {
+        for (int x = 0; x < grid->width(); ++x) {
+            float out = 0;
+            ASSERT_TRUE(grid->valueAt(x, y, out));
+            float out2 = 0;
+            ASSERT_TRUE(grid2->valueAt(x, y, out2));
+            ASSERT_EQ(out, out2);
+        }
+    }
+    float out = 0;
+    ASSERT_TRUE(grid2->valueAt(0, 0, out));
+    EXPECT_NEAR(out, -30.1676, 1e-4);
+}
+
+// ---------------------------------------------------------------------------
+
+TEST_F(GridTest, proj_prefetch_grids_for_extent) {
+    EXPECT_FALSE(
+        proj_prefetch_grids_for_extent(m_ctxt, nullptr, 2, 49, 3, 50));
+
+    auto noop = proj_create(m_ctxt, "+proj=noop");
+    ASSERT_NE(noop, nullptr);
+    EXPECT_FALSE(proj_prefetch_grids_for_extent(m_ctxt, noop, 2, 49, 3, 50));
+    proj_destroy(noop);
+
+    auto P = proj_create(
+        m_ctxt, "+proj=vgridshift +grids=tests/egm96_15_downsampled.gtx "
+                "+multiplier=1");
+    ASSERT_NE(P, nullptr);
+    EXPECT_FALSE(proj_prefetch_grids_for_extent(m_ctxt, P, 2, 50, 3, 49));
+    EXPECT_TRUE(proj_prefetch_grids_for_extent(m_ctxt, P, 2, 49, 3, 50));
+    // Crossing the antimeridian
+    EXPECT_TRUE(proj_prefetch_grids_for_extent(m_ctxt, P, 170, -10, -170, 10));
+
+    // Transforming while grids are being prefetched
+    PJ_COORD c = proj_coord(0, 0, 0, 0);
+    c = proj_trans(P, PJ_FWD, c);
+    EXPECT_NEAR(c.xyz.z, 17.2340, 1e-4);
+    proj_destroy(P);
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(GridTest, HorizontalShiftGridSet_null) {
     auto gridSet = NS_PROJ::HorizontalShiftGridSet::open(m_ctxt, "null");
     ASSERT_NE(gridSet, nullptr);
@@ -117,6 +174,58 @@ TEST_F(GridTest, HorizontalShiftGridSet_null) {
 
 // ---------------------------------------------------------------------------
 
+TEST_F(GridTest, HorizontalShiftGridSet_gridAt_cache) {
+    // gridAt() reuses its previous result for nearby points: check it
+    // against a freshly opened grid set, along paths going in and out of
+    // subgrids and top-level grids
+    auto gridSet = NS_PROJ::HorizontalShiftGridSet::open(
+        m_ctxt, "tests/ntv2_0_downsampled.gsb");
+    ASSERT_NE(gridSet, nullptr);
+
+    const struct {
+        double lon0, lat0, lon1, lat1;
+    } paths[] = {
+        {-84.0, 42.6, -81.0, 41.7},  // crosses the ONwinsor subgrid
+        {-88.8, 50.0, -87.2, 50.0},  // from CAwest to CAeast
+        {-100.0, 59.0, -100.0, 61.0} // from CAwest to CAnorth
+    };
+    constexpr int N = 200;
+    for (const auto &path : paths) {
+        std::set<std::string> names;
+        for (int i = 0; i <= N; i++) {
+            // Zigzag around the path
+            const double zigzag = (i % 2) ? 0.01 : -0.01;
+            const double lon =
+                (path.lon0 + (path.lon1 - path.lon0) * i / N + zigzag) / 180 *
+                M_PI;
+            const double lat =
+                (path.lat0 + (path.lat1 - path.lat0) * i / N + zigzag) / 180 *
+                M_PI;
+            auto refGridSet = NS_PROJ::HorizontalShiftGridSet::open(
+                m_ctxt, "tests/ntv2_0_downsampled.gsb");
+            ASSERT_NE(refGridSet, nullptr);
+            const auto grid = gridSet->gridAt(lon, lat);
+            const auto refGrid = refGridSet->gridAt(lon, lat);
+            ASSERT_EQ(grid == nullptr, refGrid == nullptr) << i;
+            if (grid) {
+                EXPECT_EQ(grid->name(), refGrid->name()) << i;
+                EXPECT_EQ(grid->extentAndRes().west,
+                          refGrid->extentAndRes().west)
+                    << i;
+                EXPECT_EQ(grid->extentAndRes().south,
+                          refGrid->extentAndRes().south)
+                    << i;
+                names.insert(grid->name());
+            } else {
+                names.insert(std::string());
+            }
+        }
+        EXPECT_GE(names.size(), 2U);
+    }
+}
+
+// ---------------------------------------------------------------------------
+
 TEST_F(GridTest, GenericShiftGridSet_null) {
     auto gridSet = NS_PROJ::GenericShiftGridSet::open(m_ctxt, "null");
     ASSERT_NE(gridSet, nullptr);